@@ -1,5 +1,9 @@
+#include "instrumentation.hpp"
+#include "timing.hpp"
+
 #include <algorithm>
 #include <array>
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_template_test_macros.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_all.hpp>
@@ -17,7 +21,7 @@
 #define __PRETTY_FUNCTION__ __FUNCSIG__
 #endif
 
-template <typename T, typename Container = std::deque<T>>
+template <typename T, typename Container = std::deque<T>, typename TTimingPolicy = Instrumentation::Timing::Disabled>
 class Stack
 {
 private:
@@ -58,6 +62,7 @@ public:
     template <typename TArg>
     void push(TArg&& value) // universal reference
     {
+        Instrumentation::Timing::ScopedTimer<TTimingPolicy, "Stack::push"> timer;
         container.push_back(std::forward<TArg>(value));
     }
 
@@ -73,13 +78,14 @@ public:
 
     void pop(T& value)
     {
+        Instrumentation::Timing::ScopedTimer<TTimingPolicy, "Stack::pop"> timer;
         value = std::move_if_noexcept(container.back());
         container.pop_back();
     }
 };
 
-template <typename T, typename Container>
-bool Stack<T, Container>::empty() const
+template <typename T, typename Container, typename TTimingPolicy>
+bool Stack<T, Container, TTimingPolicy>::empty() const
 {
     return container.empty();
 }
@@ -281,6 +287,122 @@ TEST_CASE("Construct from range")
     REQUIRE(stack.top() == 42);
 }
 
+TEST_CASE("Stack - copies & moves", "[stack]")
+{
+    using Instrumentation::Event;
+
+    Stack<Probe<std::string>> stack;
+
+    SECTION("push of lvalue copies")
+    {
+        const Probe<std::string> text{"text"};
+
+        Instrumentation::Scope scope;
+        stack.push(text);
+
+        REQUIRE(scope.counts().copies() == 1);
+        REQUIRE(scope.counts().moves() == 0);
+    }
+
+    SECTION("push of rvalue moves")
+    {
+        Instrumentation::Scope scope;
+        stack.push(Probe<std::string>{"text"});
+
+        REQUIRE(scope.counts().copies() == 0);
+        REQUIRE(scope.counts()[Event::move_constructed] == 1);
+    }
+
+    SECTION("pop moves a top item to an argument")
+    {
+        stack.push(Probe<std::string>{"text"});
+        Probe<std::string> item;
+
+        Instrumentation::Scope scope;
+        stack.pop(item);
+
+        REQUIRE(scope.counts().copies() == 0);
+        REQUIRE(scope.counts()[Event::move_assigned] == 1);
+        REQUIRE(scope.counts().destructions() == 1);
+        REQUIRE(item == "text");
+    }
+
+    SECTION("construction from range copies every item")
+    {
+        const std::vector<Probe<std::string>> words = {Probe<std::string>{"one"}, Probe<std::string>{"two"}, Probe<std::string>{"three"}};
+
+        Instrumentation::Scope scope;
+        Stack<Probe<std::string>> stack_of_words(words);
+
+        REQUIRE(scope.counts().copies() == 3);
+        REQUIRE(scope.counts().moves() == 0);
+    }
+}
+
+TEST_CASE("Stack - timing policy", "[stack]")
+{
+    using namespace Instrumentation;
+
+    auto count_of = [](std::string_view trace_point) {
+        const auto snapshot = Timing::snapshot(trace_point);
+        return snapshot ? snapshot->count : 0;
+    };
+
+    const uint64_t pushes_before = count_of("Stack::push");
+    const uint64_t pops_before = count_of("Stack::pop");
+
+    Stack<int, std::vector<int>, Timing::Histograms<>> stack;
+    for (int i = 0; i < 100; ++i)
+        stack.push(i);
+
+    int item;
+    stack.pop(item);
+
+    REQUIRE(count_of("Stack::push") - pushes_before == 100);
+    REQUIRE(count_of("Stack::pop") - pops_before == 1);
+}
+
+TEST_CASE("Stack - benchmarks", "[.][benchmark]")
+{
+    constexpr int count = 1'000;
+
+    auto push_pop_all = [](auto& stack) {
+        for (int i = 0; i < count; ++i)
+            stack.push(i);
+
+        int sum = 0;
+        for (int item; !stack.empty(); sum += item)
+            stack.pop(item);
+        return sum;
+    };
+
+    BENCHMARK("Stack<int, deque> - push & pop 1000 items")
+    {
+        Stack<int> stack;
+        return push_pop_all(stack);
+    };
+
+    BENCHMARK("Stack<int, vector> - push & pop 1000 items")
+    {
+        Stack<int, std::vector<int>> stack;
+        return push_pop_all(stack);
+    };
+
+    const std::vector<std::string> words(count, std::string(32, 'x'));
+
+    BENCHMARK("Stack<string, deque> - construct from range & pop")
+    {
+        Stack<std::string> stack(words);
+        return pop_all(stack).size();
+    };
+
+    BENCHMARK("Stack<string, vector> - construct from range & pop")
+    {
+        Stack<std::string, std::vector<std::string>> stack(words);
+        return pop_all(stack).size();
+    };
+}
+
 template <typename T>
 inline constexpr T pi = 3.141592653589793238;
 
@@ -1,12 +1,24 @@
+#include "generator.hpp"
+
+#include <algorithm>
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <charconv>
+#include <cstring>
 #include <forward_list>
 #include <iostream>
 #include <list>
 #include <map>
+#include <memory>
+#include <numeric>
 #include <set>
 #include <source_location>
+#include <sstream>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 using namespace std::literals;
@@ -37,6 +49,7 @@ TEST_CASE("Iterator")
     static_assert(Iterator<std::vector<int>::iterator>);
     static_assert(Iterator<std::vector<int>::const_iterator>);
     static_assert(Iterator<std::forward_list<int>::const_iterator>);
+    static_assert(Iterator<Coroutines::generator<int>::iterator>);
 }
 
 /*********************
@@ -77,20 +90,21 @@ Indexable concept
 **********************/
 
 template <typename C>
-concept Indexable = TODO;
+concept Indexable = requires(C& c, size_t index) { c[index]; }
+    || requires(C& c, const typename C::key_type& key) { c[key]; };
 
 TEST_CASE("Indexable")
 {
-    // static_assert(Indexable<std::vector<int>>);
-    // static_assert(Indexable<std::map<int, std::string>>);
-    // static_assert(Indexable<std::map<std::string, std::string>>);
-    // static_assert(Indexable<std::unordered_map<int, int>>);
-    // static_assert(Indexable<std::vector<bool>>);
-    // static_assert(Indexable<std::string>);
-    // int arr[32];
-    // static_assert(Indexable<decltype(arr)>);
-    // static_assert(!Indexable<std::list<int>>);
-    // static_assert(!Indexable<std::set<int>>);
+    static_assert(Indexable<std::vector<int>>);
+    static_assert(Indexable<std::map<int, std::string>>);
+    static_assert(Indexable<std::map<std::string, std::string>>);
+    static_assert(Indexable<std::unordered_map<int, int>>);
+    static_assert(Indexable<std::vector<bool>>);
+    static_assert(Indexable<std::string>);
+    int arr[32];
+    static_assert(Indexable<decltype(arr)>);
+    static_assert(!Indexable<std::list<int>>);
+    static_assert(!Indexable<std::set<int>>);
 }
 
 /*********************
@@ -100,19 +114,19 @@ IndexableStdContainer concept
 **********************/
 
 template <typename C>
-concept IndexableStdContainer = TODO;
+concept IndexableStdContainer = StdContainer<C> && Indexable<C>;
 
 TEST_CASE("IndexableStdContainer")
 {
-    // static_assert(IndexableStdContainer<std::vector<int>>);
-    // static_assert(!IndexableStdContainer<std::list<int>>);
-    // static_assert(!IndexableStdContainer<std::set<int>>);
-    // static_assert(IndexableStdContainer<std::map<int, std::string>>);
-    // static_assert(IndexableStdContainer<std::map<std::string, std::string>>);
-    // static_assert(IndexableStdContainer<std::unordered_map<int, int>>);
-    // static_assert(IndexableStdContainer<std::vector<bool>>);
-    // static_assert(IndexableStdContainer<std::string>);
-    // static_assert(!IndexableStdContainer<int[10]>);
+    static_assert(IndexableStdContainer<std::vector<int>>);
+    static_assert(!IndexableStdContainer<std::list<int>>);
+    static_assert(!IndexableStdContainer<std::set<int>>);
+    static_assert(IndexableStdContainer<std::map<int, std::string>>);
+    static_assert(IndexableStdContainer<std::map<std::string, std::string>>);
+    static_assert(IndexableStdContainer<std::unordered_map<int, int>>);
+    static_assert(IndexableStdContainer<std::vector<bool>>);
+    static_assert(IndexableStdContainer<std::string>);
+    static_assert(!IndexableStdContainer<int[10]>);
 }
 
 void print_all(const StdContainer auto& container)
@@ -139,9 +153,482 @@ void print_all(const IndexableStdContainer auto& container)
 
 TEST_CASE("container concepts")
 {
-    // std::vector vec = {1, 2, 3, 4};
-    // print_all(vec);
+    std::vector vec = {1, 2, 3, 4};
+    print_all(vec);
+
+    std::list lst{1, 2, 3};
+    print_all(lst);
+}
+
+/*********************
+Range serializer
+1. contiguous ranges of arithmetic values are converted in batches with std::to_chars
+2. other containers (e.g. node based std::map/std::set) are streamed in chunks
+3. text mode - the same format as print_all (items followed by a space)
+4. binary mode - raw dump of items without padding (pairs are dumped as key & value)
+**********************/
+
+namespace Serialization
+{
+    enum class Mode
+    {
+        text,
+        binary
+    };
+
+    inline constexpr size_t chunk_size = 64 * 1024;
+
+    template <typename T>
+    struct IsPair : std::false_type
+    { };
+
+    template <typename K, typename V>
+    struct IsPair<std::pair<K, V>> : std::true_type
+    { };
+
+    // written by operator<< as characters, not as numbers
+    template <typename T>
+    concept NarrowCharacter = std::same_as<T, char> || std::same_as<T, signed char> || std::same_as<T, unsigned char>;
+
+    // operator<< of std::ostream is deleted for wchar_t & char8_t/char16_t/char32_t
+    template <typename T>
+    concept TextArithmetic = std::is_arithmetic_v<T>
+        && !std::same_as<T, wchar_t> && !std::same_as<T, char8_t> && !std::same_as<T, char16_t> && !std::same_as<T, char32_t>;
+
+    template <typename T>
+    concept TextItem = TextArithmetic<T> || std::convertible_to<const T&, std::string_view>;
+
+    template <typename T>
+    concept TextSerializable = TextItem<T> || (IsPair<T>::value && TextItem<typename T::first_type> && TextItem<typename T::second_type>);
+
+    // the object representation is the value - no padding bytes (float & double have none either)
+    template <typename T>
+    concept PaddingFree = std::has_unique_object_representations_v<T> || std::same_as<T, float> || std::same_as<T, double>;
+
+    template <typename T>
+    concept BinarySerializable = PaddingFree<T>
+        || (IsPair<T>::value && PaddingFree<typename T::first_type> && PaddingFree<typename T::second_type>);
+
+    template <typename Container>
+    concept ContiguousArithmeticContainer = StdContainer<Container>
+        && std::contiguous_iterator<typename Container::const_iterator>
+        && TextArithmetic<typename Container::value_type>;
+
+    // longest to_text output for arithmetic types + separator
+    inline constexpr size_t max_text_length = 32;
+
+    // the same text as operator<< of std::ostream with the default flags - %g with precision 6 for floating point
+    template <TextArithmetic T>
+    char* to_text(char* first, char* last, T value)
+    {
+        if constexpr (std::same_as<T, bool>)
+        {
+            *first = value ? '1' : '0'; // without std::boolalpha
+            return first + 1;
+        }
+        else if constexpr (NarrowCharacter<T>)
+        {
+            *first = static_cast<char>(value);
+            return first + 1;
+        }
+        else if constexpr (std::is_floating_point_v<T>)
+            return std::to_chars(first, last, value, std::chars_format::general, 6).ptr;
+        else
+            return std::to_chars(first, last, value).ptr;
+    }
+
+    class ChunkWriter
+    {
+        std::ostream& out;
+        std::unique_ptr<char[]> buffer{new char[chunk_size]};
+        size_t size{};
+
+    public:
+        explicit ChunkWriter(std::ostream& out)
+            : out{out}
+        { }
+
+        ChunkWriter(const ChunkWriter&) = delete;
+        ChunkWriter& operator=(const ChunkWriter&) = delete;
+
+        ~ChunkWriter()
+        {
+            flush();
+        }
+
+        void flush()
+        {
+            out.write(buffer.get(), size);
+            size = 0;
+        }
+
+        size_t free_space() const
+        {
+            return chunk_size - size;
+        }
+
+        char* position()
+        {
+            return buffer.get() + size;
+        }
+
+        void commit(char* end)
+        {
+            size = end - buffer.get();
+        }
+
+        void put_bytes(const char* data, size_t count)
+        {
+            while (count > 0)
+            {
+                if (free_space() == 0)
+                    flush();
+
+                const size_t n = std::min(count, free_space());
+                std::memcpy(position(), data, n);
+                size += n;
+                data += n;
+                count -= n;
+            }
+        }
+
+        template <TextItem T>
+        void put_text(const T& item)
+        {
+            if constexpr (TextArithmetic<T>)
+            {
+                if (free_space() < max_text_length)
+                    flush();
+                commit(to_text(position(), position() + max_text_length, item));
+            }
+            else
+            {
+                const std::string_view text = item;
+                put_bytes(text.data(), text.size());
+            }
+        }
+
+        template <TextSerializable T>
+        void put_item(const T& item)
+        {
+            if constexpr (IsPair<T>::value)
+            {
+                put_text(item.first);
+                put_bytes(":", 1);
+                put_text(item.second);
+            }
+            else
+                put_text(item);
+
+            put_bytes(" ", 1);
+        }
+
+        template <BinarySerializable T>
+        void put_binary(const T& item)
+        {
+            if constexpr (IsPair<T>::value)
+            {
+                put_binary(item.first);
+                put_binary(item.second);
+            }
+            else
+                put_bytes(reinterpret_cast<const char*>(&item), sizeof(T));
+        }
+    };
+
+    template <Mode mode = Mode::text, StdContainer Container>
+        requires (mode == Mode::text && TextSerializable<std::remove_cvref_t<typename Container::value_type>>)
+        || (mode == Mode::binary && BinarySerializable<std::remove_cvref_t<typename Container::value_type>>)
+    void serialize(std::ostream& out, const Container& container)
+    {
+        using T = typename Container::value_type;
+
+        if constexpr (mode == Mode::binary && std::contiguous_iterator<typename Container::const_iterator> && PaddingFree<T>)
+        {
+            out.write(reinterpret_cast<const char*>(std::data(container)), std::size(container) * sizeof(T)); // no copy at all
+        }
+        else if constexpr (mode == Mode::text && ContiguousArithmeticContainer<Container>)
+        {
+            ChunkWriter writer{out};
+            const T* data = std::data(container);
+            size_t count = std::size(container);
+
+            while (count > 0)
+            {
+                // capacity is checked once per batch, not per item
+                const size_t batch = std::min(count, writer.free_space() / max_text_length);
+                if (batch == 0)
+                {
+                    writer.flush();
+                    continue;
+                }
+
+                char* pos = writer.position();
+                for (size_t i = 0; i < batch; ++i)
+                {
+                    pos = to_text(pos, pos + max_text_length - 1, data[i]);
+                    *pos++ = ' ';
+                }
+                writer.commit(pos);
+
+                data += batch;
+                count -= batch;
+            }
+
+            writer.put_bytes("\n", 1);
+        }
+        else
+        {
+            ChunkWriter writer{out};
+
+            for (const auto& item : container)
+            {
+                if constexpr (mode == Mode::text)
+                    writer.put_item(item);
+                else
+                    writer.put_binary(item);
+            }
+
+            if constexpr (mode == Mode::text)
+                writer.put_bytes("\n", 1);
+        }
+    }
+} // namespace Serialization
+
+TEST_CASE("range serializer")
+{
+    using namespace Serialization;
+
+    SECTION("text - contiguous fast path")
+    {
+        std::vector<int> vec = {1, -2, 3, 665};
+        std::ostringstream out;
+        serialize(out, vec);
+        REQUIRE(out.str() == "1 -2 3 665 \n");
+
+        std::vector<double> dbls = {3.14, -0.5};
+        std::ostringstream out_dbls;
+        serialize(out_dbls, dbls);
+        REQUIRE(out_dbls.str() == "3.14 -0.5 \n");
+    }
+
+    SECTION("text - floating point as operator<<")
+    {
+        const std::vector<double> dbls = {3.14159265, 1234567.0, 1e-5, 100000.0, -0.0};
+        const std::list<double> lst(dbls.begin(), dbls.end());
+        const std::map<int, double> dict = {{1, 3.14159265}, {2, 1234567.0}};
+
+        std::ostringstream expected, expected_dict;
+        for (double item : dbls)
+            expected << item << " ";
+        expected << "\n";
+        for (const auto& [key, value] : dict)
+            expected_dict << key << ":" << value << " ";
+        expected_dict << "\n";
+
+        std::ostringstream out_vec, out_lst, out_dict;
+        serialize(out_vec, dbls);
+        serialize(out_lst, lst);
+        serialize(out_dict, dict);
 
-    // std::list lst{1, 2, 3};
-    // print_all(lst);
+        REQUIRE(expected.str() == "3.14159 1.23457e+06 1e-05 100000 -0 \n");
+        REQUIRE(out_vec.str() == expected.str());
+        REQUIRE(out_lst.str() == expected.str());
+        REQUIRE(out_dict.str() == expected_dict.str());
+    }
+
+    SECTION("text - many chunks")
+    {
+        std::vector<int> vec(100'000);
+        std::iota(vec.begin(), vec.end(), 0);
+        std::ostringstream out_vec;
+        serialize(out_vec, vec);
+
+        std::list<int> lst(vec.begin(), vec.end());
+        std::ostringstream out_lst;
+        serialize(out_lst, lst);
+
+        std::ostringstream expected;
+        for (int item : vec)
+            expected << item << " ";
+        expected << "\n";
+
+        REQUIRE(out_vec.str() == expected.str());
+        REQUIRE(out_lst.str() == expected.str());
+    }
+
+    SECTION("text - node based containers")
+    {
+        std::set<int> numbers = {3, 1, 2};
+        std::ostringstream out;
+        serialize(out, numbers);
+        REQUIRE(out.str() == "1 2 3 \n");
+
+        std::map<int, std::string> dict = {{1, "one"}, {2, "two"}};
+        std::ostringstream out_dict;
+        serialize(out_dict, dict);
+        REQUIRE(out_dict.str() == "1:one 2:two \n");
+    }
+
+    SECTION("text - characters & bools as operator<<")
+    {
+        const std::string text = "abc";
+        const std::vector<int8_t> bytes = {'x', 'y'};
+        const std::vector<bool> flags = {true, false, true};
+        const std::list<bool> lst_flags(flags.begin(), flags.end());
+        const std::map<char, bool> dict = {{'a', true}, {'b', false}};
+
+        std::ostringstream expected_text, expected_bytes, expected_flags, expected_dict;
+        for (char c : text)
+            expected_text << c << " ";
+        expected_text << "\n";
+        for (int8_t b : bytes)
+            expected_bytes << b << " ";
+        expected_bytes << "\n";
+        for (bool flag : flags)
+            expected_flags << flag << " ";
+        expected_flags << "\n";
+        for (const auto& [key, value] : dict)
+            expected_dict << key << ":" << value << " ";
+        expected_dict << "\n";
+
+        std::ostringstream out_text, out_bytes, out_flags, out_lst_flags, out_dict;
+        serialize(out_text, text);
+        serialize(out_bytes, bytes);
+        serialize(out_flags, flags);
+        serialize(out_lst_flags, lst_flags);
+        serialize(out_dict, dict);
+
+        REQUIRE(expected_text.str() == "a b c \n");
+        REQUIRE(out_text.str() == expected_text.str());
+        REQUIRE(out_bytes.str() == expected_bytes.str());
+        REQUIRE(expected_flags.str() == "1 0 1 \n");
+        REQUIRE(out_flags.str() == expected_flags.str());
+        REQUIRE(out_lst_flags.str() == expected_flags.str());
+        REQUIRE(out_dict.str() == expected_dict.str());
+    }
+
+    SECTION("binary")
+    {
+        std::vector<int> vec = {1, 2, 3};
+        std::ostringstream out_vec;
+        serialize<Mode::binary>(out_vec, vec);
+
+        std::list<int> lst = {1, 2, 3};
+        std::ostringstream out_lst;
+        serialize<Mode::binary>(out_lst, lst);
+
+        REQUIRE(out_vec.str().size() == 3 * sizeof(int));
+        REQUIRE(out_vec.str() == out_lst.str());
+
+        std::map<int, double> dict = {{1, 1.5}};
+        std::ostringstream out_dict;
+        serialize<Mode::binary>(out_dict, dict);
+        REQUIRE(out_dict.str().size() == sizeof(int) + sizeof(double));
+    }
+
+    SECTION("binary - no padding bytes")
+    {
+        struct Padded
+        {
+            char tag;
+            int value;
+        };
+
+        static_assert(!BinarySerializable<Padded>);
+        static_assert(BinarySerializable<std::pair<char, int>>);
+
+        std::vector<std::pair<char, int>> pairs = {{'a', 1}, {'b', 2}};
+        std::map<char, int> dict(pairs.begin(), pairs.end());
+
+        std::ostringstream out_pairs, out_dict;
+        serialize<Mode::binary>(out_pairs, pairs);
+        serialize<Mode::binary>(out_dict, dict);
+
+        REQUIRE(out_pairs.str().size() == 2 * (sizeof(char) + sizeof(int)));
+        REQUIRE(out_pairs.str() == out_dict.str());
+    }
+}
+
+namespace
+{
+    struct NullBuffer : std::streambuf
+    {
+        int_type overflow(int_type c) override
+        {
+            return c;
+        }
+
+        std::streamsize xsputn(const char*, std::streamsize count) override
+        {
+            return count;
+        }
+    };
+} // namespace
+
+TEST_CASE("range serializer - benchmarks", "[.][benchmark]")
+{
+    constexpr int item_count = 10'000'000;
+
+    NullBuffer null_buffer;
+    std::ostream null_out{&null_buffer};
+
+    auto per_item_stream = [&null_out](const auto& container) {
+        for (const auto& item : container)
+            null_out << item << " ";
+        null_out << "\n";
+    };
+
+    std::vector<int> vec(item_count);
+    std::iota(vec.begin(), vec.end(), 0);
+
+    BENCHMARK("vector<int> - per item operator<<")
+    {
+        per_item_stream(vec);
+    };
+
+    BENCHMARK("vector<int> - serialize text")
+    {
+        Serialization::serialize(null_out, vec);
+    };
+
+    BENCHMARK("vector<int> - serialize binary")
+    {
+        Serialization::serialize<Serialization::Mode::binary>(null_out, vec);
+    };
+
+    {
+        std::list<int> lst(vec.begin(), vec.end());
+
+        BENCHMARK("list<int> - per item operator<<")
+        {
+            per_item_stream(lst);
+        };
+
+        BENCHMARK("list<int> - serialize text")
+        {
+            Serialization::serialize(null_out, lst);
+        };
+    }
+
+    std::map<int, int> dict;
+    for (int i = 0; i < item_count; ++i)
+        dict.emplace_hint(dict.end(), i, i);
+
+    BENCHMARK("map<int, int> - per item operator<<")
+    {
+        for (const auto& [key, value] : dict)
+            null_out << key << ":" << value << " ";
+        null_out << "\n";
+    };
+
+    BENCHMARK("map<int, int> - serialize text")
+    {
+        Serialization::serialize(null_out, dict);
+    };
+
+    BENCHMARK("map<int, int> - serialize binary")
+    {
+        Serialization::serialize<Serialization::Mode::binary>(null_out, dict);
+    };
 }
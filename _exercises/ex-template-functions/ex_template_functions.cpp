@@ -1,13 +1,25 @@
+#include "generator.hpp"
+#include "thread_pool.hpp"
+
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <cstring>
+#include <deque>
 #include <functional>
 #include <iostream>
 #include <iterator>
+#include <limits>
 #include <list>
 #include <numeric>
+#include <random>
+#include <span>
+#include <stdexcept>
 #include <string>
+#include <thread>
 #include <vector>
 
 using namespace std;
@@ -48,6 +60,36 @@ namespace TODO
             }
             return end;
         }
+
+        // parallel - the first match (the lowest position) wins, blocks after a found match are skipped
+        template <std::random_access_iterator It, AlgorithmPredicate<It> Predicate>
+        It find_if(Executors::ThreadPool& pool, It begin, It end, Predicate pred)
+        {
+            using TDiff = std::iter_difference_t<It>;
+
+            const TDiff size = end - begin;
+            std::atomic<TDiff> found{size};
+
+            Executors::parallel_for_blocks(pool, TDiff{0}, size, [&](TDiff first, TDiff last) {
+                constexpr TDiff step = 1'024; // found is checked once per step - the inner loop stays tight
+
+                for (; first < last && first < found.load(std::memory_order_relaxed); first += step)
+                {
+                    const It step_end = begin + std::min(last, first + step);
+                    const It pos = std::find_if(begin + first, step_end, pred);
+                    if (pos != step_end)
+                    {
+                        const TDiff i = pos - begin;
+                        TDiff current = found.load(std::memory_order_relaxed);
+                        while (i < current && !found.compare_exchange_weak(current, i, std::memory_order_relaxed))
+                        { }
+                        return;
+                    }
+                }
+            });
+
+            return begin + found.load();
+        }
     } // namespace Constrained
 } // namespace TODO
 
@@ -79,6 +121,34 @@ TEST_CASE("my find if")
 
         REQUIRE(pos == end(vec));
     }
+
+    SECTION("lazy generator")
+    {
+        auto numbers = [](int n) -> Coroutines::generator<int> {
+            for (int i = 0; i < n; ++i)
+                co_yield i * 7 % 1'000;
+        };
+
+        auto values = numbers(1'000);
+        auto pos = TODO::find_if(begin(values), end(values), [](int x) { return x == 665; });
+
+        REQUIRE(pos != end(values));
+        REQUIRE(*pos == 665);
+    }
+
+    SECTION("parallel - the first match")
+    {
+        Executors::ThreadPool pool{4};
+
+        vector<int> vec(100'000, 1);
+        vec[77'777] = 665;
+        vec[88'888] = 665;
+
+        auto pos = TODO::find_if(pool, begin(vec), end(vec), [](int x) { return x == 665; });
+
+        REQUIRE(pos - begin(vec) == 77'777);
+        REQUIRE(TODO::find_if(pool, begin(vec), end(vec), [](int x) { return x == 42; }) == end(vec));
+    }
 }
 
 namespace TODO
@@ -141,6 +211,16 @@ namespace ExplainStd
         return acc;
     }
 
+    // parallel - partial sums of blocks are added in order, so acc + ... keeps the order of the elements
+    template <std::random_access_iterator It, typename TZero>
+    TZero accumulate(Executors::ThreadPool& pool, It begin, It end, TZero acc)
+    {
+        return Executors::parallel_reduce(pool, begin, end, std::move(acc), [](TZero lhs, const auto& rhs) {
+            lhs += rhs;
+            return lhs;
+        });
+    }
+
     template <typename TContainer>
     auto begin(TContainer& container)
     {
@@ -229,6 +309,31 @@ TEST_CASE("my accumulate")
 
         double result = std::accumulate(vec.begin(), vec.end(), 0.0);
     }
+
+    SECTION("lazy generator")
+    {
+        auto words = []() -> Coroutines::generator<std::string> {
+            co_yield "one";
+            co_yield "two";
+            co_yield "three";
+        }();
+
+        REQUIRE(ExplainStd::accumulate(begin(words), end(words), "Tekst: "s) == "Tekst: onetwothree");
+        REQUIRE(TODO::accumulate(words.begin(), words.end()).empty()); // a generator can be iterated once
+    }
+
+    SECTION("parallel")
+    {
+        Executors::ThreadPool pool{4};
+
+        std::vector<int> data(100'000);
+        std::iota(data.begin(), data.end(), 0);
+        REQUIRE(ExplainStd::accumulate(pool, data.begin(), data.end(), 0L) == 4'999'950'000L);
+
+        std::vector<std::string> words(1'000, "ab");
+        REQUIRE(ExplainStd::accumulate(pool, words.begin(), words.end(), "Tekst: "s)
+            == ExplainStd::accumulate(words.begin(), words.end(), "Tekst: "s));
+    }
 }
 
 namespace TODO
@@ -255,6 +360,7 @@ namespace TODO
     static_assert(is_same_v<RangeValue_t<list<string>>, string>);
     static_assert(is_same_v<RangeValue_t<array<double, 5>>, double>);
     static_assert(is_same_v<RangeValue_t<int[10]>, int>);
+    static_assert(is_same_v<RangeValue_t<Coroutines::generator<int>>, int>);
 
     template <typename TContainer>
     inline constexpr bool is_memset_friendly = std::contiguous_iterator<Iterator_t<TContainer>> && std::is_trivially_copyable_v<RangeValue_t<TContainer>>;
@@ -291,6 +397,30 @@ namespace TODO
         //     item = T{};
         // }
     }
+
+    // parallel - blocks of the container are zeroed by the workers; sequential for not random access containers
+    template <typename TContainer>
+    Implementation zero(Executors::ThreadPool& pool, TContainer& container)
+    {
+        using T = RangeValue_t<TContainer>;
+
+        if constexpr (is_memset_friendly<TContainer>)
+        {
+            T* data = std::data(container);
+            Executors::parallel_for_blocks(pool, size_t{0}, std::size(container), [data](size_t first, size_t last) {
+                std::memset(data + first, 0, sizeof(T) * (last - first));
+            });
+            return Implementation::Optimized;
+        }
+        else if constexpr (std::random_access_iterator<Iterator_t<TContainer>>)
+        {
+            auto first = std::begin(container);
+            Executors::parallel_for(pool, size_t{0}, std::size(container), [first](size_t i) { first[i] = T{}; });
+            return Implementation::Generic;
+        }
+        else
+            return zero(container);
+    }
 } // namespace TODO
 
 TEST_CASE("zero")
@@ -328,4 +458,549 @@ TEST_CASE("zero")
 
         REQUIRE(words == std::list{""s, ""s, ""s});
     }
+
+    SECTION("parallel")
+    {
+        Executors::ThreadPool pool{4};
+
+        std::vector<int> numbers(10'000, 42);
+        REQUIRE(zero(pool, numbers) == Implementation::Optimized);
+        REQUIRE(std::ranges::all_of(numbers, [](int n) { return n == 0; }));
+
+        std::deque<std::string> queued(1'000, "text");
+        REQUIRE(zero(pool, queued) == Implementation::Generic);
+        REQUIRE(std::ranges::all_of(queued, [](const auto& s) { return s.empty(); }));
+
+        std::list<std::string> words = {"one", "two", "three"};
+        REQUIRE(zero(pool, words) == Implementation::Generic);
+        REQUIRE(words == std::list{""s, ""s, ""s});
+    }
+}
+
+TEST_CASE("accumulate - benchmarks", "[.][benchmark]")
+{
+    std::vector<int> data(10'000);
+    std::iota(data.begin(), data.end(), 0);
+
+    BENCHMARK("TODO::ver_1::accumulate")
+    {
+        return TODO::ver_1::accumulate(data.begin(), data.end());
+    };
+
+    BENCHMARK("TODO::ver_2::accumulate")
+    {
+        return TODO::ver_2::accumulate(data.begin(), data.end());
+    };
+
+    BENCHMARK("TODO::ver_3::accumulate")
+    {
+        return TODO::ver_3::accumulate(data.begin(), data.end());
+    };
+
+    BENCHMARK("ExplainStd::accumulate")
+    {
+        return ExplainStd::accumulate(data.begin(), data.end(), 0);
+    };
+
+    BENCHMARK("std::accumulate")
+    {
+        return std::accumulate(data.begin(), data.end(), 0);
+    };
+}
+
+namespace
+{
+    Coroutines::generator<int> iota(int n)
+    {
+        for (int i = 0; i < n; ++i)
+            co_yield i;
+    }
+} // namespace
+
+// streaming - the generator keeps one frame instead of the materialized vector (4 MB for 1M ints)
+TEST_CASE("accumulate - generator vs vector - benchmarks", "[.][benchmark]")
+{
+    constexpr int size = 1'000'000;
+
+    BENCHMARK("ExplainStd::accumulate - materialized vector")
+    {
+        std::vector<int> numbers(size);
+        std::iota(numbers.begin(), numbers.end(), 0);
+        return ExplainStd::accumulate(numbers.begin(), numbers.end(), 0L);
+    };
+
+    BENCHMARK("ExplainStd::accumulate - generator")
+    {
+        auto numbers = iota(size);
+        return ExplainStd::accumulate(numbers.begin(), numbers.end(), 0L);
+    };
+}
+
+TEST_CASE("parallel algorithms - benchmarks", "[.][benchmark]")
+{
+    std::vector<int> data(10'000'000);
+    std::iota(data.begin(), data.end(), 0);
+
+    BENCHMARK("ExplainStd::accumulate")
+    {
+        return ExplainStd::accumulate(data.begin(), data.end(), 0L);
+    };
+
+    BENCHMARK("TODO::find_if - not found")
+    {
+        return TODO::find_if(data.begin(), data.end(), [](int x) { return x < 0; });
+    };
+
+    BENCHMARK("TODO::zero")
+    {
+        return TODO::zero(data);
+    };
+
+    // scaling - 1, 2, 4, ... up to hardware_concurrency workers
+    const size_t max_threads = std::max(1u, std::thread::hardware_concurrency());
+    for (size_t threads = 1; threads <= max_threads; threads *= 2)
+    {
+        Executors::ThreadPool pool{threads};
+        const std::string suffix = " - " + std::to_string(threads) + " threads";
+
+        BENCHMARK("ExplainStd::accumulate(pool)" + suffix)
+        {
+            return ExplainStd::accumulate(pool, data.begin(), data.end(), 0L);
+        };
+
+        BENCHMARK("TODO::find_if(pool) - not found" + suffix)
+        {
+            return TODO::find_if(pool, data.begin(), data.end(), [](int x) { return x < 0; });
+        };
+
+        BENCHMARK("TODO::zero(pool)" + suffix)
+        {
+            return TODO::zero(pool, data);
+        };
+    }
+}
+
+namespace
+{
+    // the same layout as int - but not trivially copyable, so zero() takes the generic path
+    struct NonTrivialInt
+    {
+        int value = 0;
+
+        NonTrivialInt() = default;
+
+        NonTrivialInt(const NonTrivialInt& other)
+            : value{other.value}
+        { }
+
+        NonTrivialInt& operator=(const NonTrivialInt& other)
+        {
+            value = other.value;
+            return *this;
+        }
+    };
+} // namespace
+
+TEST_CASE("zero - benchmarks", "[.][benchmark]")
+{
+    using namespace TODO;
+
+    constexpr size_t size = 4'096;
+
+    std::vector<int> numbers(size, 42);
+    std::vector<NonTrivialInt> wrapped_numbers(size);
+    std::deque<int> queued_numbers(size, 42);
+
+    REQUIRE(zero(numbers) == Implementation::Optimized);
+    REQUIRE(zero(wrapped_numbers) == Implementation::Generic);
+    REQUIRE(zero(queued_numbers) == Implementation::Generic);
+
+    BENCHMARK("Optimized - vector<int>")
+    {
+        zero(numbers);
+        return numbers.data();
+    };
+
+    BENCHMARK("Generic - vector<NonTrivialInt>")
+    {
+        zero(wrapped_numbers);
+        return wrapped_numbers.data();
+    };
+
+    BENCHMARK("Generic - deque<int>")
+    {
+        zero(queued_numbers);
+        return &queued_numbers.front();
+    };
+}
+
+namespace TODO
+{
+    // sum, min & max of a contiguous range - cached in a segment tree over blocks of block_size elements
+    //
+    //   std::vector<int> data = ...;
+    //   TODO::AggregateCache cache{data};
+    //
+    //   cache.set(42, 665);   // writes data[42] & marks its block dirty - O(1)
+    //   cache.sum();          // re-aggregates the dirty blocks only, then O(1)
+    //   cache.min(100, 5'000); // whole blocks come from the tree, two partial blocks are scanned - O(block_size + log(blocks))
+    //
+    // Writes made directly to the range have to be reported with invalidate(index).
+    // Queries are const, but refresh the cache - a cache is not synchronized.
+    template <typename TRange, typename TSum = RangeValue_t<TRange>>
+        requires std::contiguous_iterator<Iterator_t<TRange>> && std::is_arithmetic_v<RangeValue_t<TRange>>
+    class AggregateCache
+    {
+    public:
+        using value_type = RangeValue_t<TRange>;
+        using sum_type = TSum;
+
+        static constexpr size_t block_size = 64;
+
+        struct Aggregate
+        {
+            TSum sum{};
+            value_type min = std::numeric_limits<value_type>::max();
+            value_type max = std::numeric_limits<value_type>::lowest();
+
+            void add(value_type value) noexcept
+            {
+                sum += value;
+                min = std::min(min, value);
+                max = std::max(max, value);
+            }
+
+            void add(const Aggregate& other) noexcept
+            {
+                sum += other.sum;
+                min = std::min(min, other.min);
+                max = std::max(max, other.max);
+            }
+        };
+
+    private:
+        std::span<std::remove_reference_t<std::iter_reference_t<Iterator_t<TRange>>>> items;
+        size_t blocks;
+        mutable std::vector<Aggregate> tree;    // leaves (blocks) at [blocks, 2 * blocks), node i = tree[2i] + tree[2i + 1]
+        mutable std::vector<char> dirty;        // per block
+        mutable std::vector<size_t> dirty_blocks;
+
+    public:
+        explicit AggregateCache(TRange& range)
+            : items{std::data(range), std::size(range)}
+            , blocks{(items.size() + block_size - 1) / block_size}
+            , tree(2 * blocks)
+            , dirty(blocks, false)
+        {
+            rebuild();
+        }
+
+        size_t size() const noexcept
+        {
+            return items.size();
+        }
+
+        value_type operator[](size_t index) const noexcept
+        {
+            return items[index];
+        }
+
+        void set(size_t index, value_type value)
+        {
+            check_index(index);
+            items[index] = value;
+            mark_dirty(index / block_size);
+        }
+
+        // reports a write made directly to the range
+        void invalidate(size_t index)
+        {
+            check_index(index);
+            mark_dirty(index / block_size);
+        }
+
+        // re-aggregates everything - after bulk writes made directly to the range
+        void rebuild()
+        {
+            for (size_t block = 0; block < blocks; ++block)
+                tree[blocks + block] = scan(block * block_size, std::min(items.size(), (block + 1) * block_size));
+
+            for (size_t node = blocks; node-- > 1;)
+                tree[node] = combine(tree[2 * node], tree[2 * node + 1]);
+
+            std::ranges::fill(dirty, false);
+            dirty_blocks.clear();
+        }
+
+        Aggregate aggregate() const
+        {
+            refresh();
+            return blocks ? tree[1] : Aggregate{};
+        }
+
+        // [first, last)
+        Aggregate aggregate(size_t first, size_t last) const
+        {
+            if (first > last || last > items.size())
+                throw std::out_of_range("AggregateCache - invalid range");
+
+            const size_t full_first = (first + block_size - 1) / block_size;
+            const size_t full_last = last / block_size;
+
+            if (full_first >= full_last)
+                return scan(first, last); // at most two partial blocks
+
+            refresh();
+
+            Aggregate result = scan(first, full_first * block_size);
+            for (size_t left = full_first + blocks, right = full_last + blocks; left < right; left /= 2, right /= 2)
+            {
+                if (left & 1)
+                    result.add(tree[left++]);
+                if (right & 1)
+                    result.add(tree[--right]);
+            }
+            result.add(scan(full_last * block_size, last));
+
+            return result;
+        }
+
+        TSum sum() const
+        {
+            return aggregate().sum;
+        }
+
+        TSum sum(size_t first, size_t last) const
+        {
+            return aggregate(first, last).sum;
+        }
+
+        value_type min() const
+        {
+            return min(0, items.size());
+        }
+
+        value_type min(size_t first, size_t last) const
+        {
+            check_not_empty(first, last);
+            return aggregate(first, last).min;
+        }
+
+        value_type max() const
+        {
+            return max(0, items.size());
+        }
+
+        value_type max(size_t first, size_t last) const
+        {
+            check_not_empty(first, last);
+            return aggregate(first, last).max;
+        }
+
+    private:
+        static Aggregate combine(Aggregate lhs, const Aggregate& rhs) noexcept
+        {
+            lhs.add(rhs);
+            return lhs;
+        }
+
+        Aggregate scan(size_t first, size_t last) const noexcept
+        {
+            Aggregate result;
+            for (size_t i = first; i < last; ++i)
+                result.add(items[i]);
+            return result;
+        }
+
+        void mark_dirty(size_t block)
+        {
+            if (!dirty[block])
+            {
+                dirty_blocks.push_back(block); // first - if it throws, the block is not flagged & the next write retries
+                dirty[block] = true;
+            }
+        }
+
+        // only the dirty blocks & their paths to the root are re-aggregated
+        void refresh() const
+        {
+            for (size_t block : dirty_blocks)
+            {
+                dirty[block] = false;
+
+                size_t node = blocks + block;
+                tree[node] = scan(block * block_size, std::min(items.size(), (block + 1) * block_size));
+                for (node /= 2; node >= 1; node /= 2)
+                    tree[node] = combine(tree[2 * node], tree[2 * node + 1]);
+            }
+            dirty_blocks.clear();
+        }
+
+        void check_index(size_t index) const
+        {
+            if (index >= items.size())
+                throw std::out_of_range("AggregateCache - index out of range");
+        }
+
+        void check_not_empty(size_t first, size_t last) const
+        {
+            if (first >= last)
+                throw std::out_of_range("AggregateCache - min/max of an empty range");
+        }
+    };
+} // namespace TODO
+
+TEST_CASE("aggregate cache")
+{
+    SECTION("whole range & sub-ranges - the same as TODO::accumulate & std::minmax")
+    {
+        std::vector<int> data(1'000);
+        std::ranges::generate(data, [gen = std::mt19937{665}, dist = std::uniform_int_distribution<int>{-1'000, 1'000}] mutable { return dist(gen); });
+
+        TODO::AggregateCache cache{data};
+        static_assert(std::is_same_v<decltype(cache.sum()), int>);
+
+        REQUIRE(cache.sum() == TODO::accumulate(data.begin(), data.end()));
+        REQUIRE(cache.min() == std::ranges::min(data));
+        REQUIRE(cache.max() == std::ranges::max(data));
+
+        for (auto [first, last] : {std::pair{0, 1'000}, {0, 64}, {1, 63}, {63, 65}, {10, 990}, {128, 512}, {999, 1'000}, {500, 500}})
+        {
+            INFO("[" << first << ", " << last << ")");
+            REQUIRE(cache.sum(first, last) == TODO::accumulate(data.begin() + first, data.begin() + last));
+            if (first != last)
+            {
+                REQUIRE(cache.min(first, last) == *std::min_element(data.begin() + first, data.begin() + last));
+                REQUIRE(cache.max(first, last) == *std::max_element(data.begin() + first, data.begin() + last));
+            }
+        }
+    }
+
+    SECTION("updates - re-aggregated before the next query")
+    {
+        std::vector<int> data(1'000, 1);
+        TODO::AggregateCache cache{data};
+        REQUIRE(cache.sum() == 1'000);
+
+        cache.set(0, 665);
+        cache.set(1, -665);
+        cache.set(999, 42);
+        REQUIRE(data[999] == 42);
+
+        REQUIRE(cache.sum() == 1'000 - 3 + 42);
+        REQUIRE(cache.min() == -665);
+        REQUIRE(cache.max() == 665);
+        REQUIRE(cache.sum(2, 999) == 997);
+
+        std::mt19937 rnd{42};
+        for (int round = 0; round < 100; ++round)
+        {
+            const size_t index = rnd() % data.size();
+            cache.set(index, static_cast<int>(rnd() % 2'001) - 1'000);
+
+            const size_t first = rnd() % data.size();
+            const size_t last = first + rnd() % (data.size() - first) + 1;
+            REQUIRE(cache.sum(first, last) == TODO::accumulate(data.begin() + first, data.begin() + last));
+            REQUIRE(cache.min(first, last) == *std::min_element(data.begin() + first, data.begin() + last));
+            REQUIRE(cache.max(first, last) == *std::max_element(data.begin() + first, data.begin() + last));
+        }
+    }
+
+    SECTION("writes made directly to the range - invalidate & rebuild")
+    {
+        double data[100] = {};
+        TODO::AggregateCache<double[100]> cache{data};
+
+        data[70] = 2.5;
+        REQUIRE(cache.sum() == 0.0);
+        cache.invalidate(70);
+        REQUIRE(cache.sum() == 2.5);
+
+        std::ranges::fill(data, 1.0);
+        cache.rebuild();
+        REQUIRE(cache.sum() == 100.0);
+        REQUIRE(cache.max(10, 90) == 1.0);
+    }
+
+    SECTION("wider sum type")
+    {
+        std::vector<int> data(100'000, std::numeric_limits<int>::max());
+        TODO::AggregateCache<std::vector<int>, long long> cache{data};
+
+        REQUIRE(cache.sum() == 100'000LL * std::numeric_limits<int>::max());
+    }
+
+    SECTION("invalid ranges & indexes")
+    {
+        std::vector<int> data(100, 1);
+        TODO::AggregateCache cache{data};
+
+        REQUIRE_THROWS_AS(cache.sum(50, 101), std::out_of_range);
+        REQUIRE_THROWS_AS(cache.sum(60, 50), std::out_of_range);
+        REQUIRE_THROWS_AS(cache.min(50, 50), std::out_of_range);
+        REQUIRE_THROWS_AS(cache.set(100, 1), std::out_of_range);
+
+        std::vector<int> empty;
+        TODO::AggregateCache empty_cache{empty};
+        REQUIRE(empty_cache.sum() == 0);
+        REQUIRE_THROWS_AS(empty_cache.max(), std::out_of_range);
+    }
+}
+
+// a few updates between queries of a large array - recomputing vs re-aggregating the dirty blocks
+TEST_CASE("aggregate cache - benchmarks", "[.][benchmark]")
+{
+    constexpr size_t size = 1'000'000;
+
+    std::vector<int> data(size);
+    std::ranges::generate(data, [gen = std::mt19937{665}, dist = std::uniform_int_distribution<int>{-1'000, 1'000}] mutable { return dist(gen); });
+    std::vector<int> cached_data = data;
+    TODO::AggregateCache cache{cached_data};
+
+    std::vector<size_t> positions(1'024);
+    std::ranges::generate(positions, [gen = std::mt19937{42}] mutable { return gen() % size; });
+    size_t next = 0;
+
+    for (size_t updates : {1, 16, 256})
+    {
+        const std::string suffix = " - " + std::to_string(updates) + " updates + sum";
+
+        BENCHMARK("recompute - TODO::accumulate" + suffix)
+        {
+            for (size_t i = 0; i < updates; ++i)
+                data[positions[next++ % positions.size()]] = static_cast<int>(i);
+            return TODO::accumulate(data.begin(), data.end());
+        };
+
+        BENCHMARK("AggregateCache" + suffix)
+        {
+            for (size_t i = 0; i < updates; ++i)
+                cache.set(positions[next++ % positions.size()], static_cast<int>(i));
+            return cache.sum();
+        };
+    }
+
+    BENCHMARK("recompute - TODO::accumulate - 1 update + sum of a sub-range")
+    {
+        data[positions[next++ % positions.size()]] = 1;
+        return TODO::accumulate(data.begin() + size / 4 + 1, data.begin() + 3 * size / 4 - 1);
+    };
+
+    BENCHMARK("AggregateCache - 1 update + sum of a sub-range")
+    {
+        cache.set(positions[next++ % positions.size()], 1);
+        return cache.sum(size / 4 + 1, 3 * size / 4 - 1);
+    };
+
+    BENCHMARK("recompute - std::ranges::minmax - 1 update + min & max")
+    {
+        data[positions[next++ % positions.size()]] = 1;
+        return std::ranges::minmax(data);
+    };
+
+    BENCHMARK("AggregateCache - 1 update + min & max")
+    {
+        cache.set(positions[next++ % positions.size()], 1);
+        return std::pair{cache.min(), cache.max()};
+    };
 }
@@ -1,9 +1,13 @@
+#include "thread_pool.hpp"
+
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <iostream>
+#include <thread>
 #include <type_traits>
 
 using namespace std;
@@ -65,6 +69,26 @@ TEST_CASE("select for tuple")
     REQUIRE(vt::select<3, 2, 1, 0>(row) == std::make_tuple(std::vector{1, 2, 3}, "last-name", "first-name", 1));
 }
 
+TEST_CASE("select for tuple - benchmarks", "[.][benchmark]")
+{
+    const std::tuple<int, std::string, std::string, std::vector<int>> row{1, "first-name-long-enough-to-allocate", "last-name", std::vector<int>(16, 42)};
+
+    BENCHMARK("vt::select<0, 2, 3>")
+    {
+        return vt::select<0, 2, 3>(row);
+    };
+
+    BENCHMARK("hand-written make_tuple(get<0>, get<2>, get<3>)")
+    {
+        return std::make_tuple(std::get<0>(row), std::get<2>(row), std::get<3>(row));
+    };
+
+    BENCHMARK("vt::select<0, 0, 0>")
+    {
+        return vt::select<0, 0, 0>(row);
+    };
+}
+
 /////////////////////////////////////////////////
 
 namespace vt
@@ -75,6 +99,13 @@ namespace vt
         for(size_t i = 0; i < count; ++i)
             func(args...);
     }
+
+    // parallel - the calls run concurrently on the workers of the pool, so func has to be thread safe
+    template <typename F, typename... TArgs>
+    void call_n_times(Executors::ThreadPool& pool, size_t count, F func, const TArgs&... args)
+    {
+        Executors::parallel_for(pool, size_t{0}, count, [&](size_t) { func(args...); });
+    }
 } // namespace vt
 
 TEST_CASE("call_n_times wrapper")
@@ -94,6 +125,53 @@ TEST_CASE("call_n_times wrapper")
     // REQUIRE(std::all_of(begin(results), end(results), [](const auto& item) { return item == std::make_tuple(1, "one"s); }));
 }
 
+TEST_CASE("call_n_times wrapper - parallel")
+{
+    Executors::ThreadPool pool{4};
+
+    std::atomic<int> counter{};
+    std::atomic<size_t> length{};
+
+    vt::call_n_times(pool, 1'000, [&](int step, const std::string& text) {
+        counter += step;
+        length += text.size();
+    }, 2, "one"s);
+
+    REQUIRE(counter == 2'000);
+    REQUIRE(length == 3'000);
+}
+
+TEST_CASE("call_n_times wrapper - benchmarks", "[.][benchmark]")
+{
+    auto work = [](std::atomic<uint64_t>& total, uint64_t seed) {
+        uint64_t x = seed;
+        for (int i = 0; i < 1'000; ++i)
+            x = x * 6364136223846793005ull + 1442695040888963407ull;
+        total.fetch_add(x & 1, std::memory_order_relaxed);
+    };
+
+    std::atomic<uint64_t> total{};
+
+    BENCHMARK("vt::call_n_times")
+    {
+        vt::call_n_times(10'000, work, std::ref(total), uint64_t{42});
+        return total.load();
+    };
+
+    // scaling - 1, 2, 4, ... up to hardware_concurrency workers
+    const size_t max_threads = std::max(1u, std::thread::hardware_concurrency());
+    for (size_t threads = 1; threads <= max_threads; threads *= 2)
+    {
+        Executors::ThreadPool pool{threads};
+
+        BENCHMARK("vt::call_n_times(pool) - " + std::to_string(threads) + " threads")
+        {
+            vt::call_n_times(pool, 10'000, work, std::ref(total), uint64_t{42});
+            return total.load();
+        };
+    }
+}
+
 ///////////////////////////////////////////////
 
 namespace vt
@@ -0,0 +1,417 @@
+// Benchmark report
+//
+// Runs the hidden [benchmark] test cases of the project's Catch2 test binaries, writes the
+// mean & standard deviation of every benchmark as JSON and - given a baseline written by an
+// earlier run - flags benchmarks whose mean got slower than the threshold allows.
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <optional>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace BenchReport
+{
+    constexpr int exit_regression = 1;
+    constexpr int exit_error = 2;
+    constexpr int exit_no_baseline = 77; // SKIP_RETURN_CODE of the CTest tests
+
+    struct Suite
+    {
+        std::string name;
+        fs::path binary;
+    };
+
+    struct Options
+    {
+        std::vector<Suite> suites;
+        fs::path output;
+        fs::path baseline;
+        double threshold = 0.10;
+        int samples = 100;
+    };
+
+    struct Result
+    {
+        std::string suite;
+        std::string test_case;
+        std::string name;
+        double mean_ns{};
+        double mean_low_ns{}; // bounds of the mean's confidence interval (bootstrapped by Catch2)
+        double mean_high_ns{};
+        double std_dev_ns{};
+    };
+
+    std::string key_of(const Result& result)
+    {
+        return result.suite + " / " + result.test_case + " / " + result.name;
+    }
+
+    std::string quoted(const std::string& text)
+    {
+        return "\"" + text + "\"";
+    }
+
+    //////////////////////////////////////
+    // Catch2 XML reporter output - one element per line
+
+    std::string xml_unescaped(std::string_view text)
+    {
+        static const std::pair<std::string_view, char> entities[] = {
+            {"&quot;", '"'}, {"&apos;", '\''}, {"&lt;", '<'}, {"&gt;", '>'}, {"&amp;", '&'}};
+
+        std::string result;
+        for (size_t i = 0; i < text.size(); ++i)
+        {
+            const auto entity = std::ranges::find_if(entities, [&](const auto& e) { return text.substr(i).starts_with(e.first); });
+            if (entity != std::end(entities))
+            {
+                result += entity->second;
+                i += entity->first.size() - 1;
+            }
+            else
+                result += text[i];
+        }
+        return result;
+    }
+
+    std::optional<std::string> xml_attribute(const std::string& line, std::string_view name)
+    {
+        const std::string prefix = " " + std::string{name} + "=\"";
+        const size_t start = line.find(prefix);
+        if (start == std::string::npos)
+            return std::nullopt;
+
+        const size_t first = start + prefix.size();
+        return xml_unescaped(std::string_view{line}.substr(first, line.find('"', first) - first));
+    }
+
+    bool is_element(const std::string& line, std::string_view name)
+    {
+        const size_t first = line.find_first_not_of(' ');
+        return first != std::string::npos && std::string_view{line}.substr(first).starts_with("<" + std::string{name} + " ");
+    }
+
+    std::vector<Result> parse_catch_xml(const std::string& suite, const fs::path& path)
+    {
+        std::ifstream xml{path};
+        if (!xml)
+            throw std::runtime_error("cannot open " + path.string());
+
+        std::vector<Result> results;
+        std::string test_case;
+        Result current;
+        for (std::string line; std::getline(xml, line);)
+        {
+            if (is_element(line, "TestCase"))
+                test_case = xml_attribute(line, "name").value_or("");
+            else if (is_element(line, "BenchmarkResults"))
+                current = Result{suite, test_case, xml_attribute(line, "name").value_or("")};
+            else if (is_element(line, "mean"))
+            {
+                current.mean_ns = std::stod(xml_attribute(line, "value").value_or("0"));
+                current.mean_low_ns = std::stod(xml_attribute(line, "lowerBound").value_or("0"));
+                current.mean_high_ns = std::stod(xml_attribute(line, "upperBound").value_or("0"));
+            }
+            else if (is_element(line, "standardDeviation"))
+            {
+                current.std_dev_ns = std::stod(xml_attribute(line, "value").value_or("0"));
+                results.push_back(current);
+            }
+        }
+        return results;
+    }
+
+    // returns false when the test binary reports a failure
+    bool run_suite(const Suite& suite, const Options& options, const fs::path& xml, std::vector<Result>& results)
+    {
+        const std::string command = quoted(suite.binary.string()) + " " + quoted("[benchmark]")
+            + " --reporter xml --out " + quoted(xml.string())
+            + " --benchmark-samples " + std::to_string(options.samples);
+
+        std::cout << "running " << suite.name << ": " << suite.binary.filename().string() << std::endl;
+        const int status = std::system(command.c_str());
+
+        auto suite_results = parse_catch_xml(suite.name, xml);
+        results.insert(results.end(), suite_results.begin(), suite_results.end());
+
+        return status == 0;
+    }
+
+    //////////////////////////////////////
+    // JSON - one benchmark per line
+
+    std::string json_escaped(std::string_view text)
+    {
+        std::string result;
+        for (char c : text)
+        {
+            if (c == '"' || c == '\\')
+                result += '\\';
+            result += c;
+        }
+        return result;
+    }
+
+    std::optional<std::string> json_string(const std::string& line, std::string_view key)
+    {
+        const std::string prefix = "\"" + std::string{key} + "\": \"";
+        const size_t key_pos = line.find(prefix);
+        if (key_pos == std::string::npos)
+            return std::nullopt;
+
+        std::string value;
+        for (size_t i = key_pos + prefix.size(); i < line.size() && line[i] != '"'; ++i)
+        {
+            if (line[i] == '\\' && i + 1 < line.size())
+                ++i;
+            value += line[i];
+        }
+        return value;
+    }
+
+    std::optional<double> json_number(const std::string& line, std::string_view key)
+    {
+        const std::string prefix = "\"" + std::string{key} + "\": ";
+        const size_t key_pos = line.find(prefix);
+        if (key_pos == std::string::npos)
+            return std::nullopt;
+
+        return std::stod(line.substr(key_pos + prefix.size()));
+    }
+
+    std::vector<Result> read_json(const fs::path& path)
+    {
+        std::ifstream json{path};
+        if (!json)
+            throw std::runtime_error("cannot open " + path.string());
+
+        std::vector<Result> results;
+        for (std::string line; std::getline(json, line);)
+        {
+            auto suite = json_string(line, "suite");
+            if (!suite)
+                continue;
+
+            results.push_back(Result{
+                *suite,
+                json_string(line, "test_case").value_or(""),
+                json_string(line, "name").value_or(""),
+                json_number(line, "mean_ns").value_or(0.0),
+                json_number(line, "mean_low_ns").value_or(0.0),
+                json_number(line, "mean_high_ns").value_or(0.0),
+                json_number(line, "std_dev_ns").value_or(0.0)});
+        }
+        return results;
+    }
+
+    void write_json(const std::vector<Result>& results, const fs::path& path)
+    {
+        if (path.has_parent_path())
+            fs::create_directories(path.parent_path());
+
+        std::ofstream out{path};
+        out << "{\n  \"benchmarks\": [\n";
+
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            const auto& r = results[i];
+            out << "    {\"suite\": \"" << json_escaped(r.suite) << "\", \"test_case\": \"" << json_escaped(r.test_case)
+                << "\", \"name\": \"" << json_escaped(r.name) << "\", \"mean_ns\": " << r.mean_ns
+                << ", \"mean_low_ns\": " << r.mean_low_ns << ", \"mean_high_ns\": " << r.mean_high_ns << ", \"std_dev_ns\": " << r.std_dev_ns << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+
+        out << "  ]\n}\n";
+    }
+
+    // results of the suites that were run replace their entries in an existing file - other suites are kept
+    void update_json(const std::vector<Result>& results, const std::vector<Suite>& suites, const fs::path& path)
+    {
+        std::vector<Result> merged;
+        if (fs::exists(path))
+        {
+            std::set<std::string> updated;
+            for (const auto& suite : suites)
+                updated.insert(suite.name);
+
+            std::ranges::copy_if(read_json(path), std::back_inserter(merged), [&](const Result& r) { return !updated.contains(r.suite); });
+        }
+
+        merged.insert(merged.end(), results.begin(), results.end());
+        write_json(merged, path);
+    }
+
+    //////////////////////////////////////
+    // report
+
+    void print(const std::vector<Result>& results, std::ostream& out)
+    {
+        out << "\n"
+            << std::right << std::setw(14) << "mean [ns]" << std::setw(14) << "std dev [ns]" << "  benchmark\n"
+            << std::string(98, '-') << "\n";
+
+        for (const auto& r : results)
+            out << std::fixed << std::setprecision(2) << std::setw(14) << r.mean_ns << std::setw(14) << r.std_dev_ns << "  " << key_of(r) << "\n";
+    }
+
+    // a regression is slower by more than the threshold with the confidence intervals of both means apart -
+    // a slowdown within the noise of the measurements is only reported
+    bool is_regression(const Result& current, const Result& baseline, double threshold)
+    {
+        return current.mean_ns > baseline.mean_ns * (1.0 + threshold) && current.mean_low_ns > baseline.mean_high_ns;
+    }
+
+    // returns the number of regressions
+    int compare(const std::vector<Result>& results, const std::vector<Result>& baseline, const std::vector<Suite>& suites,
+        double threshold, std::ostream& out)
+    {
+        std::map<std::string, const Result*> baseline_by_key;
+        for (const auto& b : baseline)
+            baseline_by_key.emplace(key_of(b), &b);
+
+        out << "\ncomparison with the baseline - threshold " << std::fixed << std::setprecision(1) << threshold * 100 << "%\n"
+            << std::right << std::setw(10) << "change" << std::setw(16) << "baseline [ns]" << std::setw(16) << "current [ns]" << "  benchmark\n"
+            << std::string(98, '-') << "\n";
+
+        int regressions = 0;
+        for (const auto& r : results)
+        {
+            const std::string key = key_of(r);
+            const auto found = baseline_by_key.find(key);
+            if (found == baseline_by_key.end())
+            {
+                out << std::setw(10) << "new" << std::setw(16) << "-" << std::setprecision(2) << std::setw(16) << r.mean_ns << "  " << key << "\n";
+                continue;
+            }
+
+            const double base = found->second->mean_ns;
+            const double change = base > 0.0 ? r.mean_ns / base - 1.0 : 0.0;
+            const bool regression = is_regression(r, *found->second, threshold);
+            regressions += regression;
+
+            std::ostringstream percent;
+            percent << std::showpos << std::fixed << std::setprecision(1) << change * 100 << "%";
+            out << std::setw(10) << percent.str() << std::setprecision(2) << std::setw(16) << base << std::setw(16) << r.mean_ns << "  " << key
+                << (regression ? "   REGRESSION" : (change > threshold ? "   slower - within noise" : "")) << "\n";
+
+            baseline_by_key.erase(found);
+        }
+
+        // baseline entries of the suites that were run, but not reported any more
+        for (const auto& [key, b] : baseline_by_key)
+        {
+            if (std::ranges::any_of(suites, [&](const Suite& s) { return s.name == b->suite; }))
+                out << std::setw(10) << "missing" << std::setprecision(2) << std::setw(16) << b->mean_ns << std::setw(16) << "-" << "  " << key << "\n";
+        }
+
+        return regressions;
+    }
+
+    Options parse_options(int argc, char** argv)
+    {
+        Options options;
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string_view arg = argv[i];
+            auto next = [&]() -> std::string {
+                if (i + 1 >= argc)
+                    throw std::invalid_argument("missing value for " + std::string{arg});
+                return argv[++i];
+            };
+
+            if (arg == "--suite")
+            {
+                const std::string suite = next();
+                const size_t separator = suite.find('=');
+                if (separator == std::string::npos)
+                    throw std::invalid_argument("--suite expects <name>=<test binary>: " + suite);
+                options.suites.push_back(Suite{suite.substr(0, separator), suite.substr(separator + 1)});
+            }
+            else if (arg == "--output")
+                options.output = next();
+            else if (arg == "--baseline")
+                options.baseline = next();
+            else if (arg == "--threshold")
+                options.threshold = std::stod(next());
+            else if (arg == "--samples")
+                options.samples = std::stoi(next());
+            else
+                throw std::invalid_argument("unknown option " + std::string{arg});
+        }
+
+        if (options.suites.empty() || options.output.empty())
+            throw std::invalid_argument(
+                "usage: bench-report --suite <name>=<test binary> [--suite ...] --output <results.json>"
+                " [--baseline <baseline.json>] [--threshold <relative slowdown, e.g. 0.1>] [--samples <n>]");
+
+        return options;
+    }
+} // namespace BenchReport
+
+int main(int argc, char** argv)
+{
+    using namespace BenchReport;
+
+    try
+    {
+        const Options options = parse_options(argc, argv);
+
+        const fs::path xml_dir = fs::temp_directory_path();
+        bool all_succeeded = true;
+        std::vector<Result> results;
+        for (const auto& suite : options.suites)
+        {
+            const fs::path xml = xml_dir / ("bench-report-" + suite.name + ".xml");
+            all_succeeded = run_suite(suite, options, xml, results) && all_succeeded;
+            fs::remove(xml);
+        }
+
+        print(results, std::cout);
+
+        update_json(results, options.suites, options.output);
+        std::cout << "\nresults: " << options.output.string() << "\n";
+
+        if (!all_succeeded)
+        {
+            std::cerr << "bench-report: a benchmark test case failed\n";
+            return exit_regression;
+        }
+
+        if (options.baseline.empty())
+            return 0;
+
+        if (!fs::exists(options.baseline))
+        {
+            std::cout << "no baseline at " << options.baseline.string() << " - build the bench-baseline target first\n";
+            return exit_no_baseline;
+        }
+
+        const int regressions = compare(results, read_json(options.baseline), options.suites, options.threshold, std::cout);
+        if (regressions > 0)
+        {
+            std::cout << "\n" << regressions << " benchmark(s) slower than the baseline by more than "
+                      << std::fixed << std::setprecision(1) << options.threshold * 100 << "%\n";
+            return exit_regression;
+        }
+
+        return 0;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "bench-report: " << e.what() << "\n";
+        return exit_error;
+    }
+}
@@ -0,0 +1,628 @@
+// Compile-time report
+//
+// Builds generated stress translation units and the project's own targets (taken from
+// compile_commands.json) one by one, measuring wall time, peak memory and template
+// instantiation time (-ftime-trace for Clang, -ftime-report for GCC).
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+namespace CompileReport
+{
+    struct Options
+    {
+        std::string compiler;
+        std::string compiler_id;
+        std::string std_flag = "-std=c++23";
+        fs::path output_dir = "compile-time-report";
+        fs::path compile_commands;
+        bool stress = false;
+        int scale = 1;
+    };
+
+    struct Measurement
+    {
+        std::string group;
+        std::string name;
+        double wall_seconds{};
+        long peak_rss_kb{};
+        std::optional<double> instantiation_seconds;
+        bool succeeded{};
+        fs::path log;
+    };
+
+    struct ProcessResult
+    {
+        int exit_code;
+        double wall_seconds;
+        long peak_rss_kb;
+    };
+
+    // runs the command with /bin/sh - stdout & stderr go to the log file
+    ProcessResult run(const std::string& command, const fs::path& log)
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        const pid_t pid = ::fork();
+        if (pid == -1)
+            throw std::system_error(errno, std::generic_category(), "fork");
+
+        if (pid == 0)
+        {
+            const int fd = ::open(log.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            if (fd != -1)
+            {
+                ::dup2(fd, STDOUT_FILENO);
+                ::dup2(fd, STDERR_FILENO);
+                ::close(fd);
+            }
+            ::execl("/bin/sh", "sh", "-c", command.c_str(), static_cast<char*>(nullptr));
+            ::_exit(127);
+        }
+
+        int status = 0;
+        rusage usage{}; // covers the compiler driver and the waited-for compiler proper
+        if (::wait4(pid, &status, 0, &usage) == -1)
+            throw std::system_error(errno, std::generic_category(), "wait4");
+
+        const std::chrono::duration<double> wall = std::chrono::steady_clock::now() - start;
+        return {WIFEXITED(status) ? WEXITSTATUS(status) : -1, wall.count(), usage.ru_maxrss};
+    }
+
+    std::string read_file(const fs::path& path)
+    {
+        std::ifstream file{path, std::ios::binary};
+        return {std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+    }
+
+    std::string shell_quoted(const fs::path& path)
+    {
+        return "'" + path.string() + "'";
+    }
+
+    //////////////////////////////////////
+    // instantiation time
+
+    bool is_clang(const Options& options)
+    {
+        return options.compiler_id.find("Clang") != std::string::npos;
+    }
+
+    bool is_gcc(const Options& options)
+    {
+        return options.compiler_id == "GNU";
+    }
+
+    std::string timing_flags(const Options& options)
+    {
+        if (is_clang(options))
+            return " -ftime-trace";
+        if (is_gcc(options))
+            return " -ftime-report";
+        return "";
+    }
+
+    // GCC: " template instantiation  :   0.12 ( 10%)   0.01 (  1%)   0.13 ( 11%)  1234k ( 5%)" - usr, sys, wall
+    std::optional<double> gcc_instantiation_seconds(const std::string& report)
+    {
+        std::istringstream lines{report};
+        for (std::string line; std::getline(lines, line);)
+        {
+            if (!line.starts_with(" template instantiation"))
+                continue;
+
+            std::istringstream tokens{line.substr(line.find(':') + 1)};
+            std::vector<double> numbers;
+            for (std::string token; tokens >> token;)
+            {
+                if (token.find_first_of("()%k") != std::string::npos)
+                    continue;
+                try
+                {
+                    numbers.push_back(std::stod(token));
+                }
+                catch (const std::exception&)
+                { }
+            }
+
+            if (numbers.size() >= 3)
+                return numbers[2];
+        }
+        return std::nullopt;
+    }
+
+    // Clang: trace events {"ph":"X","ts":0,"dur":1234,"name":"Total InstantiateFunction",...} - dur in us
+    std::optional<double> clang_instantiation_seconds(const fs::path& trace_file)
+    {
+        const std::string trace = read_file(trace_file);
+        if (trace.empty())
+            return std::nullopt;
+
+        double total_us = 0.0;
+        bool found = false;
+        for (std::string_view name : {"\"Total InstantiateFunction\"", "\"Total InstantiateClass\""})
+        {
+            const size_t name_pos = trace.find(name);
+            if (name_pos == std::string::npos)
+                continue;
+
+            const size_t object_start = trace.rfind('{', name_pos);
+            const size_t dur_pos = trace.find("\"dur\":", object_start);
+            if (dur_pos == std::string::npos)
+                continue;
+
+            total_us += std::stod(trace.substr(dur_pos + 6));
+            found = true;
+        }
+
+        return found ? std::optional{total_us / 1e6} : std::nullopt;
+    }
+
+    //////////////////////////////////////
+    // compiling
+
+    Measurement compile(const Options& options, std::string group, std::string name, std::string command,
+        const fs::path& object_file, const fs::path& log)
+    {
+        command += timing_flags(options);
+
+        const ProcessResult result = run(command, log);
+
+        Measurement measurement{std::move(group), std::move(name), result.wall_seconds, result.peak_rss_kb, std::nullopt, result.exit_code == 0, log};
+
+        if (is_gcc(options))
+            measurement.instantiation_seconds = gcc_instantiation_seconds(read_file(log));
+        else if (is_clang(options))
+            measurement.instantiation_seconds = clang_instantiation_seconds(fs::path{object_file}.replace_extension(".json"));
+
+        return measurement;
+    }
+
+    //////////////////////////////////////
+    // generated stress translation units
+
+    std::string variadic_pack(int n)
+    {
+        std::ostringstream src;
+        src << "#include <tuple>\n\n"
+            << "template <int N>\nstruct Item\n{\n    static constexpr int value = N;\n};\n\n"
+            << "using Items = std::tuple<";
+        for (int i = 0; i < n; ++i)
+            src << (i ? ", " : "") << "Item<" << i << ">";
+        src << ">;\n\n"
+            << "static_assert(std::tuple_size_v<Items> == " << n << ");\n"
+            << "constexpr int total = std::apply([](auto... items) { return (decltype(items)::value + ... + 0); }, Items{});\n"
+            << "static_assert(total == " << n * (n - 1) / 2 << ");\n";
+        return src.str();
+    }
+
+    std::string concept_checks(int n)
+    {
+        std::ostringstream src;
+        src << "#include <concepts>\n\n"
+            << "template <typename T>\n"
+            << "concept Shape = std::regular<T> && requires(const T& shape) {\n"
+            << "    { shape.area() } -> std::convertible_to<double>;\n"
+            << "    { shape.name() } -> std::convertible_to<const char*>;\n"
+            << "};\n\n"
+            << "template <Shape T>\ndouble describe(const T& shape)\n{\n    return shape.area();\n}\n\n";
+        for (int i = 0; i < n; ++i)
+        {
+            src << "struct Shape" << i << "\n{\n    double size;\n"
+                << "    double area() const { return size * " << i << "; }\n"
+                << "    const char* name() const { return \"shape" << i << "\"; }\n"
+                << "    bool operator==(const Shape" << i << "&) const = default;\n};\n"
+                << "static_assert(Shape<Shape" << i << ">);\n"
+                << "double use" << i << "() { return describe(Shape" << i << "{1.0}); }\n\n";
+        }
+        return src.str();
+    }
+
+    std::string unroll(int n)
+    {
+        std::ostringstream src;
+        src << "#include <utility>\n\n"
+            << "template <auto N>\n"
+            << "constexpr auto unroll = [](auto expr) {\n"
+            << "    [expr]<auto... Is>(std::index_sequence<Is...>) {\n"
+            << "        ((expr(), void(Is)), ...);\n"
+            << "    }(std::make_index_sequence<N>{});\n"
+            << "};\n\n"
+            << "int counter = 0;\n\n"
+            << "void run()\n{\n    unroll<" << n << ">([] { ++counter; });\n}\n";
+        return src.str();
+    }
+
+    enum class Style
+    {
+        sfinae,
+        if_constexpr,
+        concepts
+    };
+
+    // the same is_power_of_2 & print overload sets in many namespaces - only the dispatch technique differs
+    std::string overload_set(Style style, int namespaces)
+    {
+        std::ostringstream src;
+        src << "#include <cmath>\n#include <iostream>\n#include <list>\n#include <type_traits>\n#include <vector>\n\n";
+
+        for (int i = 0; i < namespaces; ++i)
+        {
+            src << "namespace ns" << i << "\n{\n";
+            switch (style)
+            {
+            case Style::sfinae:
+                src << "    template <typename T>\n"
+                    << "    auto is_power_of_2(T value) -> std::enable_if_t<std::is_integral_v<T>, bool>\n"
+                    << "    {\n        return value > 0 && (value & (value - 1)) == 0;\n    }\n\n"
+                    << "    template <typename T>\n"
+                    << "    auto is_power_of_2(T value) -> std::enable_if_t<std::is_floating_point_v<T>, bool>\n"
+                    << "    {\n        int exponent;\n        return std::frexp(value, &exponent) == 0.5;\n    }\n\n"
+                    << "    template <typename, typename = void>\n    constexpr bool IsIterable = false;\n\n"
+                    << "    template <typename T>\n"
+                    << "    constexpr bool IsIterable<T, std::void_t<decltype(std::declval<T>().begin()), decltype(std::declval<T>().end())>> = true;\n\n"
+                    << "    template <typename T>\n"
+                    << "    auto print(const T& container) -> std::enable_if_t<IsIterable<T>>\n"
+                    << "    {\n        for (const auto& item : container)\n            std::cout << item << ' ';\n    }\n\n"
+                    << "    template <typename T>\n"
+                    << "    auto print(const T& value) -> std::enable_if_t<!IsIterable<T>>\n"
+                    << "    {\n        std::cout << value;\n    }\n";
+                break;
+            case Style::if_constexpr:
+                src << "    template <typename T>\n"
+                    << "    bool is_power_of_2(T value)\n    {\n"
+                    << "        if constexpr (std::is_integral_v<T>)\n"
+                    << "            return value > 0 && (value & (value - 1)) == 0;\n"
+                    << "        else\n        {\n            int exponent;\n            return std::frexp(value, &exponent) == 0.5;\n        }\n    }\n\n"
+                    << "    template <typename T>\n"
+                    << "    void print(const T& value)\n    {\n"
+                    << "        if constexpr (requires { value.begin(); value.end(); })\n"
+                    << "            for (const auto& item : value)\n                std::cout << item << ' ';\n"
+                    << "        else\n            std::cout << value;\n    }\n";
+                break;
+            case Style::concepts:
+                src << "    bool is_power_of_2(std::integral auto value)\n"
+                    << "    {\n        return value > 0 && (value & (value - 1)) == 0;\n    }\n\n"
+                    << "    bool is_power_of_2(std::floating_point auto value)\n"
+                    << "    {\n        int exponent;\n        return std::frexp(value, &exponent) == 0.5;\n    }\n\n"
+                    << "    template <typename T>\n"
+                    << "    concept Iterable = requires(const T& container) {\n        container.begin();\n        container.end();\n    };\n\n"
+                    << "    void print(const auto& value)\n    {\n        std::cout << value;\n    }\n\n"
+                    << "    void print(const Iterable auto& container)\n"
+                    << "    {\n        for (const auto& item : container)\n            std::cout << item << ' ';\n    }\n";
+                break;
+            }
+
+            src << "\n    bool use()\n    {\n"
+                << "        print(std::vector<int>{1, 2});\n        print(std::list<double>{1.0});\n        print(42);\n"
+                << "        return is_power_of_2(8) && is_power_of_2(64L) && is_power_of_2(256ULL) && is_power_of_2(short{2})\n"
+                << "            && is_power_of_2(8.0) && is_power_of_2(64.0f) && is_power_of_2(2.0L);\n    }\n"
+                << "} // namespace ns" << i << "\n\n";
+        }
+        return src.str();
+    }
+
+    std::vector<Measurement> compile_stress(const Options& options)
+    {
+        struct Unit
+        {
+            std::string group;
+            std::string name;
+            std::string file_name;
+            std::string source;
+        };
+
+        const int s = options.scale;
+        const std::vector<Unit> units = {
+            {"stress", "variadic pack (" + std::to_string(256 * s) + " types)", "variadic_pack.cpp", variadic_pack(256 * s)},
+            {"stress", "concept checks (" + std::to_string(500 * s) + " types)", "concept_checks.cpp", concept_checks(500 * s)},
+            {"stress", "unroll<" + std::to_string(2000 * s) + ">", "unroll.cpp", unroll(2000 * s)},
+            {"overload sets", "SFINAE", "overloads_sfinae.cpp", overload_set(Style::sfinae, 100 * s)},
+            {"overload sets", "if constexpr", "overloads_if_constexpr.cpp", overload_set(Style::if_constexpr, 100 * s)},
+            {"overload sets", "concepts", "overloads_concepts.cpp", overload_set(Style::concepts, 100 * s)},
+        };
+
+        const fs::path dir = options.output_dir / "stress";
+        fs::create_directories(dir);
+
+        std::vector<Measurement> measurements;
+        for (const auto& unit : units)
+        {
+            const fs::path source = dir / unit.file_name;
+            const fs::path object = fs::path{source}.replace_extension(".o");
+            std::ofstream{source} << unit.source;
+
+            const std::string command = shell_quoted(options.compiler) + " " + options.std_flag + " -c " + shell_quoted(source) + " -o " + shell_quoted(object);
+            measurements.push_back(compile(options, unit.group, unit.name, command, object, fs::path{source}.replace_extension(".log")));
+        }
+        return measurements;
+    }
+
+    //////////////////////////////////////
+    // project targets from compile_commands.json
+
+    // CMake writes one "key": "value" pair per line
+    std::optional<std::string> json_value(const std::string& line, std::string_view key)
+    {
+        const std::string prefix = "\"" + std::string{key} + "\":";
+        const size_t key_pos = line.find(prefix);
+        if (key_pos == std::string::npos)
+            return std::nullopt;
+
+        const size_t open = line.find('"', key_pos + prefix.size());
+        if (open == std::string::npos)
+            return std::nullopt;
+
+        std::string value;
+        for (size_t i = open + 1; i < line.size() && line[i] != '"'; ++i)
+        {
+            if (line[i] == '\\' && i + 1 < line.size())
+                ++i;
+            value += line[i];
+        }
+        return value;
+    }
+
+    // ".../CMakeFiles/tests-concepts.dir/concepts.cpp.o" -> "tests-concepts"
+    std::string target_of(const std::string& output)
+    {
+        const size_t start = output.find("CMakeFiles/");
+        const size_t end = output.find(".dir/", start);
+        if (start == std::string::npos || end == std::string::npos)
+            return output;
+        return output.substr(start + 11, end - start - 11);
+    }
+
+    // the command with its outputs (-o, -MF of Ninja) moved out of the build tree - its objects stay untouched
+    std::string redirect_outputs(std::string command, const fs::path& object)
+    {
+        auto replace_argument = [&command](std::string_view flag, const fs::path& path) {
+            const std::string option = " " + std::string{flag} + " ";
+            const size_t flag_pos = command.find(option);
+            if (flag_pos == std::string::npos)
+                return false;
+
+            const size_t start = command.find_first_not_of(' ', flag_pos + option.size());
+            const size_t end = std::min(command.find(' ', start), command.size());
+            command.replace(start, end - start, shell_quoted(path));
+            return true;
+        };
+
+        if (!replace_argument("-o", object))
+            command += " -o " + shell_quoted(object);
+        replace_argument("-MF", fs::path{object}.replace_extension(".d"));
+
+        return command;
+    }
+
+    std::vector<Measurement> compile_targets(const Options& options)
+    {
+        struct Entry
+        {
+            std::string directory, command, file, output;
+        };
+
+        std::ifstream json{options.compile_commands};
+        if (!json)
+            throw std::runtime_error("cannot open " + options.compile_commands.string());
+
+        std::vector<Entry> entries;
+        Entry entry;
+        for (std::string line; std::getline(json, line);)
+        {
+            if (auto value = json_value(line, "directory"))
+                entry.directory = *value;
+            else if (auto value = json_value(line, "command"))
+                entry.command = *value;
+            else if (auto value = json_value(line, "file"))
+                entry.file = *value;
+            else if (auto value = json_value(line, "output"))
+                entry.output = *value;
+            else if (line.find('}') != std::string::npos && !entry.command.empty())
+                entries.push_back(std::exchange(entry, Entry{}));
+        }
+
+        // older CMake versions do not write "output" - take it from the command line
+        for (auto& e : entries)
+        {
+            const size_t flag = e.command.find(" -o ");
+            if (e.output.empty() && flag != std::string::npos)
+            {
+                const size_t start = e.command.find_first_not_of(' ', flag + 4);
+                e.output = e.command.substr(start, e.command.find(' ', start) - start);
+            }
+        }
+
+        const fs::path logs = options.output_dir / "targets";
+        fs::create_directories(logs);
+
+        std::vector<Measurement> measurements;
+        for (const auto& [directory, command, file, output] : entries)
+        {
+            if (file.find("build-performance") != std::string::npos)
+                continue; // the report tool itself
+
+            const std::string target = target_of(output);
+            const std::string unit = target + "-" + fs::path{file}.filename().string();
+            const fs::path object = logs / (unit + ".o");
+            const fs::path log = logs / (unit + ".log");
+
+            std::cout << "compiling " << target << ": " << fs::path{file}.filename().string() << std::endl;
+            measurements.push_back(compile(options, "target", target, "cd " + shell_quoted(directory) + " && " + redirect_outputs(command, object), object, log));
+        }
+
+        // per target totals - a target may have several translation units
+        std::map<std::string, Measurement> totals;
+        for (const auto& m : measurements)
+        {
+            auto [it, inserted] = totals.try_emplace(m.name, m);
+            if (inserted)
+                continue;
+
+            Measurement& total = it->second;
+            total.wall_seconds += m.wall_seconds;
+            total.peak_rss_kb = std::max(total.peak_rss_kb, m.peak_rss_kb);
+            if (m.instantiation_seconds)
+                total.instantiation_seconds = total.instantiation_seconds.value_or(0.0) + *m.instantiation_seconds;
+            total.succeeded = total.succeeded && m.succeeded;
+        }
+
+        std::vector<Measurement> result;
+        for (auto& [name, total] : totals)
+            result.push_back(std::move(total));
+        return result;
+    }
+
+    //////////////////////////////////////
+    // report
+
+    void print(const std::vector<Measurement>& measurements, std::ostream& out)
+    {
+        out << "\n"
+            << std::left << std::setw(16) << "group" << std::setw(40) << "name"
+            << std::right << std::setw(10) << "wall [s]" << std::setw(12) << "peak [MB]" << std::setw(20) << "instantiation [s]" << "\n"
+            << std::string(98, '-') << "\n";
+
+        for (const auto& m : measurements)
+        {
+            out << std::left << std::setw(16) << m.group << std::setw(40) << m.name << std::right << std::fixed << std::setprecision(2)
+                << std::setw(10) << m.wall_seconds << std::setw(12) << m.peak_rss_kb / 1024.0 << std::setw(20);
+
+            if (m.instantiation_seconds)
+                out << *m.instantiation_seconds;
+            else
+                out << "-";
+
+            out << (m.succeeded ? "" : "   FAILED - see " + m.log.string()) << "\n";
+        }
+    }
+
+    std::string json_escaped(std::string_view text)
+    {
+        std::string result;
+        for (char c : text)
+        {
+            if (c == '"' || c == '\\')
+                result += '\\';
+            result += c;
+        }
+        return result;
+    }
+
+    void write_json(const std::vector<Measurement>& measurements, const Options& options, const fs::path& path)
+    {
+        std::ofstream out{path};
+        out << "{\n  \"compiler\": \"" << json_escaped(options.compiler) << "\",\n  \"compiler_id\": \"" << options.compiler_id << "\",\n"
+            << "  \"measurements\": [\n";
+
+        for (size_t i = 0; i < measurements.size(); ++i)
+        {
+            const auto& m = measurements[i];
+            out << "    {\"group\": \"" << json_escaped(m.group) << "\", \"name\": \"" << json_escaped(m.name) << "\""
+                << ", \"wall_seconds\": " << m.wall_seconds << ", \"peak_rss_kb\": " << m.peak_rss_kb
+                << ", \"instantiation_seconds\": ";
+            if (m.instantiation_seconds)
+                out << *m.instantiation_seconds;
+            else
+                out << "null";
+            out << ", \"succeeded\": " << std::boolalpha << m.succeeded << "}" << (i + 1 < measurements.size() ? "," : "") << "\n";
+        }
+
+        out << "  ]\n}\n";
+    }
+
+    Options parse_options(int argc, char** argv)
+    {
+        Options options;
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string_view arg = argv[i];
+            auto next = [&]() -> std::string {
+                if (i + 1 >= argc)
+                    throw std::invalid_argument("missing value for " + std::string{arg});
+                return argv[++i];
+            };
+
+            if (arg == "--compiler")
+                options.compiler = next();
+            else if (arg == "--compiler-id")
+                options.compiler_id = next();
+            else if (arg == "--std")
+                options.std_flag = next();
+            else if (arg == "--output")
+                options.output_dir = next();
+            else if (arg == "--compile-commands")
+                options.compile_commands = next();
+            else if (arg == "--stress")
+                options.stress = true;
+            else if (arg == "--scale")
+                options.scale = std::stoi(next());
+            else
+                throw std::invalid_argument("unknown option " + std::string{arg});
+        }
+
+        if (options.compiler.empty() || (!options.stress && options.compile_commands.empty()))
+            throw std::invalid_argument(
+                "usage: compile-report --compiler <path> [--compiler-id GNU|Clang] [--std <flag>] [--output <dir>]"
+                " [--stress] [--scale <n>] [--compile-commands <compile_commands.json>]");
+
+        return options;
+    }
+} // namespace CompileReport
+
+int main(int argc, char** argv)
+{
+    using namespace CompileReport;
+
+    try
+    {
+        const Options options = parse_options(argc, argv);
+        fs::create_directories(options.output_dir);
+
+        std::vector<Measurement> measurements;
+
+        if (options.stress)
+            measurements = compile_stress(options);
+
+        if (!options.compile_commands.empty())
+        {
+            auto targets = compile_targets(options);
+            measurements.insert(measurements.end(), targets.begin(), targets.end());
+        }
+
+        print(measurements, std::cout);
+
+        const fs::path json = options.output_dir / "compile-time-report.json";
+        write_json(measurements, options, json);
+        std::cout << "\nreport: " << json.string() << "\n";
+
+        const bool all_succeeded = std::ranges::all_of(measurements, &Measurement::succeeded);
+        return all_succeeded ? 0 : 1;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "compile-report: " << e.what() << "\n";
+        return 2;
+    }
+}
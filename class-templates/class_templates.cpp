@@ -1,8 +1,134 @@
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <cerrno>
+#include <charconv>
+#include <cmath>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <span>
+#include <stdexcept>
 #include <string>
+#include <system_error>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// == is the same as memcmp of the object representation
+template <typename T>
+concept BitwiseComparable = std::is_integral_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>;
+
+// <=> is the same as memcmp (lexicographic order of unsigned bytes)
+template <typename T>
+concept ByteLike = std::same_as<T, unsigned char> || std::same_as<T, std::byte> || std::same_as<T, char8_t>;
+
+namespace Simd
+{
+    // IEEE semantics like a scalar loop: NaN != NaN, -0.0 == 0.0
+    inline bool equal(const float* lhs, const float* rhs, size_t n)
+    {
+        size_t i = 0;
+#if defined(__SSE2__) || defined(_M_X64)
+        for (; i + 4 <= n; i += 4)
+        {
+            if (_mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(lhs + i), _mm_loadu_ps(rhs + i))) != 0xF)
+                return false;
+        }
+#endif
+        for (; i < n; ++i)
+            if (!(lhs[i] == rhs[i]))
+                return false;
+        return true;
+    }
+
+    inline bool equal(const double* lhs, const double* rhs, size_t n)
+    {
+        size_t i = 0;
+#if defined(__SSE2__) || defined(_M_X64)
+        for (; i + 2 <= n; i += 2)
+        {
+            if (_mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(lhs + i), _mm_loadu_pd(rhs + i))) != 0x3)
+                return false;
+        }
+#endif
+        for (; i < n; ++i)
+            if (!(lhs[i] == rhs[i]))
+                return false;
+        return true;
+    }
+} // namespace Simd
+
+namespace Hashing
+{
+    inline std::uint64_t mix(std::uint64_t hash)
+    {
+        hash ^= hash >> 33;
+        hash *= 0xff51afd7ed558ccd;
+        hash ^= hash >> 33;
+        hash *= 0xc4ceb9fe1a85ec53;
+        hash ^= hash >> 33;
+        return hash;
+    }
+
+    inline size_t hash_bytes(const void* data, size_t size)
+    {
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        std::uint64_t hash = size * 0x9e3779b97f4a7c15;
+
+        size_t i = 0;
+        for (; i + sizeof(std::uint64_t) <= size; i += sizeof(std::uint64_t))
+        {
+            std::uint64_t word;
+            std::memcpy(&word, bytes + i, sizeof(word));
+            hash = std::rotl(hash ^ (word * 0x87c37b91114253d5), 31) * 0x4cf5ad432745937f;
+        }
+
+        if (i < size)
+        {
+            std::uint64_t tail = 0;
+            std::memcpy(&tail, bytes + i, size - i);
+            hash = std::rotl(hash ^ (tail * 0x87c37b91114253d5), 31) * 0x4cf5ad432745937f;
+        }
+
+        return static_cast<size_t>(mix(hash));
+    }
+
+    inline void combine(size_t& seed, size_t hash)
+    {
+        seed ^= hash + 0x9e3779b97f4a7c15 + (seed << 6) + (seed >> 2);
+    }
+} // namespace Hashing
+
+namespace Expr
+{
+    template <typename TExpr>
+    concept Expression = requires { typename TExpr::is_expression; };
+} // namespace Expr
+
 template <typename T, size_t N>
 struct Array
 {
@@ -49,7 +175,14 @@ struct Array
     template <typename TSelf>
     auto& operator[](this TSelf&& self, size_t n);
 
-    auto operator<=>(const Array& other) const = default;
+    bool operator==(const Array& other) const
+        requires std::equality_comparable<T>;
+
+    auto operator<=>(const Array& other) const
+        requires std::three_way_comparable<T>;
+
+    template <Expr::Expression TExpr>
+    Array& operator=(const TExpr& expr);
 };
 
 template <typename T, size_t N>
@@ -65,6 +198,69 @@ auto& Array<T, N>::operator[](this TSelf&& self, size_t n)
     return std::forward<TSelf>(self).items[n];
 }
 
+template <typename T, size_t N>
+bool Array<T, N>::operator==(const Array& other) const
+    requires std::equality_comparable<T>
+{
+    if constexpr (BitwiseComparable<T>)
+        return std::memcmp(items, other.items, sizeof(items)) == 0;
+    else if constexpr (std::same_as<T, float> || std::same_as<T, double>)
+        return Simd::equal(items, other.items, N);
+    else
+        return std::equal(begin(), end(), other.begin());
+}
+
+template <typename T, size_t N>
+auto Array<T, N>::operator<=>(const Array& other) const
+    requires std::three_way_comparable<T>
+{
+    if constexpr (ByteLike<T>)
+        return std::memcmp(items, other.items, N) <=> 0;
+    else
+        return std::lexicographical_compare_three_way(begin(), end(), other.begin(), other.end());
+}
+
+// single fused loop - no intermediate arrays
+template <typename T, size_t N>
+template <Expr::Expression TExpr>
+Array<T, N>& Array<T, N>::operator=(const TExpr& expr)
+{
+    static_assert(TExpr::size == N, "size mismatch");
+
+    for (size_t i = 0; i < N; ++i)
+        items[i] = expr[i];
+    return *this;
+}
+
+// consistent with ==: bitwise types are hashed in bulk, -0.0 and 0.0 hash the same
+// (float & double only in bulk - long double has padding bytes, its elements are hashed one by one)
+template <typename T, size_t N>
+    requires BitwiseComparable<T> || std::floating_point<T> || requires(const T& item) { std::hash<T>{}(item); }
+struct std::hash<Array<T, N>>
+{
+    size_t operator()(const Array<T, N>& array) const noexcept
+    {
+        if constexpr (BitwiseComparable<T>)
+        {
+            return Hashing::hash_bytes(array.items, sizeof(array.items));
+        }
+        else if constexpr (std::same_as<T, float> || std::same_as<T, double>)
+        {
+            T normalized[N];
+            for (size_t i = 0; i < N; ++i)
+                normalized[i] = array.items[i] == T{} ? T{} : array.items[i];
+            return Hashing::hash_bytes(normalized, sizeof(normalized));
+        }
+        else
+        {
+            size_t seed = N;
+            for (const T& item : array)
+                Hashing::combine(seed, std::hash<T>{}(item));
+            return seed;
+        }
+    }
+};
+
 using namespace std::literals;
 
 TEST_CASE("class templates")
@@ -81,4 +277,1315 @@ TEST_CASE("class templates")
     arr1[2] = 665;
 
     REQUIRE(arr1 == Array<int, 5>{2, 4, 6, 8, 10});
-} 
\ No newline at end of file
+}
+
+namespace Defaulted
+{
+    template <typename T, size_t N>
+    struct Array
+    {
+        T items[N];
+
+        auto operator<=>(const Array& other) const = default;
+    };
+
+    template <typename T, size_t N>
+    Defaulted::Array<T, N> from(const ::Array<T, N>& array)
+    {
+        Defaulted::Array<T, N> result;
+        std::copy(array.begin(), array.end(), result.items);
+        return result;
+    }
+
+    struct ElementwiseHash
+    {
+        template <typename T, size_t N>
+        size_t operator()(const Defaulted::Array<T, N>& array) const
+        {
+            size_t seed = N;
+            for (const T& item : array.items)
+                Hashing::combine(seed, std::hash<T>{}(item));
+            return seed;
+        }
+    };
+} // namespace Defaulted
+
+namespace
+{
+    // hash of an array computed over a stack filled with garbage - padding of local copies is not initialized
+    template <typename TArray>
+    size_t hash_over_garbage(const TArray& array, unsigned char garbage)
+    {
+        volatile unsigned char stack[1024];
+        for (auto& byte : stack)
+            byte = garbage;
+        return std::hash<TArray>{}(array);
+    }
+} // namespace
+
+TEST_CASE("Array - comparisons & hashing")
+{
+    std::mt19937 rnd{665};
+
+    SECTION("bytes - same results as defaulted operators")
+    {
+        std::uniform_int_distribution<int> distr(0, 3); // small alphabet - many equal prefixes
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            Array<uint8_t, 8> a, b;
+            std::generate(a.begin(), a.end(), [&] { return static_cast<uint8_t>(distr(rnd) * 85); });
+            std::generate(b.begin(), b.end(), [&] { return static_cast<uint8_t>(distr(rnd) * 85); });
+
+            static_assert(std::is_same_v<decltype(a <=> b), std::strong_ordering>);
+            REQUIRE((a == b) == (Defaulted::from(a) == Defaulted::from(b)));
+            REQUIRE((a <=> b) == (Defaulted::from(a) <=> Defaulted::from(b)));
+            REQUIRE(std::is_eq(a <=> a));
+        }
+    }
+
+    SECTION("signed ints - elementwise order")
+    {
+        Array<int, 3> a{-1, 0, 0};
+        Array<int, 3> b{1, 0, 0};
+
+        REQUIRE(a < b);
+        REQUIRE((a <=> b) == (Defaulted::from(a) <=> Defaulted::from(b)));
+    }
+
+    SECTION("floats - IEEE semantics")
+    {
+        constexpr float nan = std::numeric_limits<float>::quiet_NaN();
+
+        Array<float, 5> a{1.0f, 0.0f, 3.0f, 4.0f, 5.0f};
+        Array<float, 5> b{1.0f, -0.0f, 3.0f, 4.0f, 5.0f};
+        Array<float, 5> c{1.0f, 0.0f, 3.0f, 4.0f, nan};
+
+        REQUIRE(a == b);
+        REQUIRE(std::hash<Array<float, 5>>{}(a) == std::hash<Array<float, 5>>{}(b));
+        REQUIRE(c != c);
+        REQUIRE((c == c) == (Defaulted::from(c) == Defaulted::from(c)));
+        REQUIRE(std::is_eq(a <=> b) == std::is_eq(Defaulted::from(a) <=> Defaulted::from(b)));
+    }
+
+    SECTION("long double - padding bytes are not hashed")
+    {
+        Array<long double, 3> a, b;
+        std::memset(&a, 0xAA, sizeof(a));
+        std::memset(&b, 0x55, sizeof(b));
+        for (size_t i = 0; i < 3; ++i)
+            a[i] = b[i] = 1.5L * i;
+        b[0] = -0.0L;
+
+        REQUIRE(a == b);
+        REQUIRE(hash_over_garbage(a, 0xAA) == hash_over_garbage(b, 0x55));
+    }
+
+    SECTION("hash")
+    {
+        Array<uint8_t, 32> digest1{}, digest2{};
+        digest2[31] = 1;
+
+        std::unordered_set<Array<uint8_t, 32>> digests{digest1, digest2, digest1};
+        REQUIRE(digests.size() == 2);
+
+        std::unordered_set<Array<std::string, 2>> names{{"Jan", "Kowalski"}, {"Jan", "Kowalski"}};
+        REQUIRE(names.size() == 1);
+    }
+}
+
+TEST_CASE("Array - comparisons & hashing - benchmarks", "[.][benchmark]")
+{
+    constexpr size_t count = 100'000;
+    std::mt19937_64 rnd{665};
+
+    std::vector<Array<uint8_t, 32>> digests(count);
+    for (auto& digest : digests)
+        std::generate(digest.begin(), digest.end(), [&] { return static_cast<uint8_t>(rnd()); });
+
+    std::vector<Array<float, 16>> features(count);
+    std::uniform_real_distribution<float> distr(-1.0f, 1.0f);
+    for (auto& feature : features)
+        std::generate(feature.begin(), feature.end(), [&] { return distr(rnd); });
+
+    auto benchmark_set = [](const std::string& name, const auto& items, auto defaulted_set, auto array_set) {
+        std::vector<decltype(Defaulted::from(items[0]))> defaulted_items;
+        for (const auto& item : items)
+            defaulted_items.push_back(Defaulted::from(item));
+
+        BENCHMARK(name + " - insert - defaulted ==, elementwise hash")
+        {
+            auto set = defaulted_set;
+            set.insert(defaulted_items.begin(), defaulted_items.end());
+            return set.size();
+        };
+
+        BENCHMARK(name + " - insert - Array")
+        {
+            auto set = array_set;
+            set.insert(items.begin(), items.end());
+            return set.size();
+        };
+
+        defaulted_set.insert(defaulted_items.begin(), defaulted_items.end());
+        array_set.insert(items.begin(), items.end());
+
+        BENCHMARK(name + " - lookup - defaulted ==, elementwise hash")
+        {
+            return std::ranges::count_if(defaulted_items, [&](const auto& item) { return defaulted_set.contains(item); });
+        };
+
+        BENCHMARK(name + " - lookup - Array")
+        {
+            return std::ranges::count_if(items, [&](const auto& item) { return array_set.contains(item); });
+        };
+    };
+
+    benchmark_set("Array<uint8_t, 32>", digests,
+        std::unordered_set<Defaulted::Array<uint8_t, 32>, Defaulted::ElementwiseHash>{},
+        std::unordered_set<Array<uint8_t, 32>>{});
+
+    benchmark_set("Array<float, 16>", features,
+        std::unordered_set<Defaulted::Array<float, 16>, Defaulted::ElementwiseHash>{},
+        std::unordered_set<Array<float, 16>>{});
+}
+
+//////////////////////////////////////
+// Memory-mapped arrays
+
+namespace Mapped
+{
+    // file layout: Header | padding up to payload_offset | items
+    struct Header
+    {
+        std::array<char, 8> magic;
+        std::uint64_t item_size;
+        std::uint64_t count;
+        std::uint64_t checksum;
+    };
+
+    inline constexpr std::array<char, 8> magic = {'A', 'R', 'R', 'A', 'Y', 'M', 'A', 'P'};
+    inline constexpr size_t payload_offset = 64;
+
+    static_assert(sizeof(Header) <= payload_offset);
+
+    // FNV-1a over 64-bit words (with rotation, so high bits reach the low ones)
+    inline std::uint64_t checksum(std::span<const std::byte> bytes)
+    {
+        constexpr std::uint64_t prime = 0x100000001b3;
+        std::uint64_t hash = 0xcbf29ce484222325;
+
+        size_t i = 0;
+        for (; i + sizeof(std::uint64_t) <= bytes.size(); i += sizeof(std::uint64_t))
+        {
+            std::uint64_t word;
+            std::memcpy(&word, bytes.data() + i, sizeof(word));
+            hash = std::rotl((hash ^ word) * prime, 29);
+        }
+
+        for (; i < bytes.size(); ++i)
+            hash = (hash ^ std::to_integer<std::uint64_t>(bytes[i])) * prime;
+
+        return hash;
+    }
+
+    template <typename T>
+        requires std::is_trivially_copyable_v<T>
+    void save(const std::filesystem::path& path, std::span<const T> items)
+    {
+        static_assert(alignof(T) <= payload_offset);
+
+        const auto payload = std::as_bytes(items);
+        const Header header{magic, sizeof(T), items.size(), checksum(payload)};
+
+        std::array<char, payload_offset> prefix{};
+        std::memcpy(prefix.data(), &header, sizeof(header));
+
+        std::ofstream file{path, std::ios::binary | std::ios::trunc};
+        file.write(prefix.data(), prefix.size());
+        file.write(reinterpret_cast<const char*>(payload.data()), payload.size());
+
+        if (!file)
+            throw std::runtime_error("Mapped::save - cannot write " + path.string());
+    }
+
+    template <typename T, size_t N>
+    void save(const std::filesystem::path& path, const Array<T, N>& array)
+    {
+        save(path, std::span<const T>{array.begin(), N});
+    }
+
+    enum class Access
+    {
+        normal,
+        sequential,
+        random,
+        will_need
+    };
+
+    enum class Verify
+    {
+        header,
+        checksum
+    };
+
+    struct Options
+    {
+        Access access = Access::normal;
+        Verify verify = Verify::checksum;
+    };
+
+#if __has_include(<sys/mman.h>)
+    // writable regions are private mappings - writes are copy-on-write and never reach the file
+    class Region
+    {
+        std::byte* address{};
+        size_t length{};
+
+    public:
+        Region(const std::filesystem::path& path, bool writable)
+        {
+            const int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd == -1)
+                throw std::system_error(errno, std::generic_category(), "open " + path.string());
+
+            struct stat file_stat{};
+            if (::fstat(fd, &file_stat) == -1)
+            {
+                const int error = errno;
+                ::close(fd);
+                throw std::system_error(error, std::generic_category(), "fstat " + path.string());
+            }
+
+            length = static_cast<size_t>(file_stat.st_size);
+            if (length > 0)
+            {
+                const int protection = writable ? PROT_READ | PROT_WRITE : PROT_READ;
+                const int flags = writable ? MAP_PRIVATE : MAP_SHARED;
+
+                void* mapped = ::mmap(nullptr, length, protection, flags, fd, 0);
+                if (mapped == MAP_FAILED)
+                {
+                    const int error = errno;
+                    ::close(fd);
+                    throw std::system_error(error, std::generic_category(), "mmap " + path.string());
+                }
+                address = static_cast<std::byte*>(mapped);
+            }
+            ::close(fd);
+        }
+
+        Region(Region&& other) noexcept
+            : address{std::exchange(other.address, nullptr)}
+            , length{std::exchange(other.length, 0)}
+        { }
+
+        Region& operator=(Region&& other) noexcept
+        {
+            Region temp{std::move(other)};
+            std::swap(address, temp.address);
+            std::swap(length, temp.length);
+            return *this;
+        }
+
+        ~Region()
+        {
+            if (address)
+                ::munmap(address, length);
+        }
+
+        std::byte* data() const
+        {
+            return address;
+        }
+
+        size_t size() const
+        {
+            return length;
+        }
+
+        void advise(Access access) const
+        {
+            if (!address)
+                return;
+
+            int advice = MADV_NORMAL;
+            switch (access)
+            {
+            case Access::normal:
+                advice = MADV_NORMAL;
+                break;
+            case Access::sequential:
+                advice = MADV_SEQUENTIAL;
+                break;
+            case Access::random:
+                advice = MADV_RANDOM;
+                break;
+            case Access::will_need:
+                advice = MADV_WILLNEED;
+                break;
+            }
+            ::madvise(address, length, advice); // only a hint - failure is not an error
+        }
+    };
+
+    // const T - read-only mapping; T - copy-on-write mapping
+    template <typename T>
+        requires std::is_trivially_copyable_v<T>
+    class mapped_span
+    {
+        Region region;
+        T* items{};
+        size_t count{};
+
+    public:
+        using iterator = T*;
+        using const_iterator = const T*;
+        using value_type = std::remove_cv_t<T>;
+        using reference = T&;
+        using const_reference = const T&;
+
+        explicit mapped_span(const std::filesystem::path& path, Options options = {})
+            : region{path, !std::is_const_v<T>}
+        {
+            if (region.size() < payload_offset)
+                throw std::runtime_error("mapped_span - file too small: " + path.string());
+
+            Header header;
+            std::memcpy(&header, region.data(), sizeof(header));
+
+            if (header.magic != magic)
+                throw std::runtime_error("mapped_span - invalid magic: " + path.string());
+
+            if (header.item_size != sizeof(T))
+                throw std::runtime_error("mapped_span - item size mismatch: " + path.string());
+
+            if (header.count > (region.size() - payload_offset) / sizeof(T))
+                throw std::runtime_error("mapped_span - file truncated: " + path.string());
+
+            items = reinterpret_cast<T*>(region.data() + payload_offset);
+            count = header.count;
+
+            if (options.verify == Verify::checksum && checksum(std::as_bytes(std::span{items, count})) != header.checksum)
+                throw std::runtime_error("mapped_span - checksum mismatch: " + path.string());
+
+            region.advise(options.access);
+        }
+
+        size_t size() const
+        {
+            return count;
+        }
+
+        iterator begin()
+        {
+            return items;
+        }
+
+        iterator end()
+        {
+            return items + count;
+        }
+
+        const_iterator begin() const
+        {
+            return items;
+        }
+
+        const_iterator end() const
+        {
+            return items + count;
+        }
+
+        template <typename TSelf>
+        auto& operator[](this TSelf&& self, size_t n)
+        {
+            return std::forward<TSelf>(self).begin()[n];
+        }
+
+        void advise(Access access) const
+        {
+            region.advise(access);
+        }
+    };
+
+    template <typename T, size_t N>
+    class mapped_array
+    {
+        mapped_span<T> items;
+
+    public:
+        using iterator = T*;
+        using const_iterator = const T*;
+        using value_type = std::remove_cv_t<T>;
+        using reference = T&;
+        using const_reference = const T&;
+
+        explicit mapped_array(const std::filesystem::path& path, Options options = {})
+            : items{path, options}
+        {
+            if (items.size() != N)
+                throw std::runtime_error("mapped_array - size mismatch: " + path.string());
+        }
+
+        size_t size() const
+        {
+            return N;
+        }
+
+        iterator begin()
+        {
+            return items.begin();
+        }
+
+        iterator end()
+        {
+            return items.end();
+        }
+
+        const_iterator begin() const
+        {
+            return items.begin();
+        }
+
+        const_iterator end() const
+        {
+            return items.end();
+        }
+
+        template <typename TSelf>
+        auto& operator[](this TSelf&& self, size_t n)
+        {
+            return std::forward<TSelf>(self).begin()[n];
+        }
+
+        void advise(Access access) const
+        {
+            items.advise(access);
+        }
+    };
+#endif
+} // namespace Mapped
+
+#if __has_include(<sys/mman.h>)
+TEST_CASE("mapped arrays")
+{
+    using namespace Mapped;
+
+    const auto path = std::filesystem::temp_directory_path() / "mapped_array_test.bin";
+
+    auto source = std::make_unique<Array<int, 1000>>();
+    std::iota(source->begin(), source->end(), 0);
+    save(path, *source);
+
+    SECTION("read-only")
+    {
+        const mapped_array<const int, 1000> mapped{path, {.access = Access::sequential}};
+
+        REQUIRE(mapped.size() == 1000);
+        REQUIRE(mapped[665] == 665);
+        REQUIRE(std::equal(mapped.begin(), mapped.end(), source->begin()));
+
+        mapped_span<const int> span{path};
+        static_assert(std::is_same_v<decltype(span[0]), const int&>);
+        REQUIRE(span.size() == 1000);
+        REQUIRE(span[999] == 999);
+    }
+
+    SECTION("copy-on-write")
+    {
+        {
+            mapped_array<int, 1000> mapped{path};
+            mapped[0] = -1;
+            REQUIRE(mapped[0] == -1);
+        }
+
+        const mapped_array<const int, 1000> original{path};
+        REQUIRE(original[0] == 0);
+    }
+
+    SECTION("header validation")
+    {
+        REQUIRE_THROWS_AS((mapped_array<const int, 999>{path}), std::runtime_error);
+        REQUIRE_THROWS_AS(mapped_span<const double>{path}, std::runtime_error);
+
+        std::filesystem::resize_file(path, payload_offset + 999 * sizeof(int));
+        REQUIRE_THROWS_AS(mapped_span<const int>{path}, std::runtime_error);
+    }
+
+    SECTION("corrupted payload")
+    {
+        {
+            std::fstream file{path, std::ios::binary | std::ios::in | std::ios::out};
+            file.seekp(payload_offset + 10 * sizeof(int));
+            file.put('\x7f');
+        }
+
+        REQUIRE_THROWS_AS(mapped_span<const int>{path}, std::runtime_error);
+        REQUIRE(mapped_span<const int>{path, {.verify = Verify::header}}.size() == 1000);
+    }
+
+    SECTION("invalid magic")
+    {
+        std::ofstream{path, std::ios::trunc} << std::string(100, 'x');
+        REQUIRE_THROWS_AS(mapped_span<const int>{path}, std::runtime_error);
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("mapped arrays - benchmarks", "[.][benchmark]")
+{
+    constexpr size_t N = 1'000'000;
+    using Table = Array<double, N>;
+
+    const auto text_path = std::filesystem::temp_directory_path() / "mapped_array_bench.txt";
+    const auto binary_path = std::filesystem::temp_directory_path() / "mapped_array_bench.bin";
+
+    {
+        auto table = std::make_unique<Table>();
+        for (size_t i = 0; i < N; ++i)
+            (*table)[i] = i * 0.25;
+
+        std::ofstream text{text_path};
+        for (double value : *table)
+            text << value << '\n';
+
+        Mapped::save(binary_path, *table);
+    }
+
+    BENCHMARK("startup - parse text")
+    {
+        std::ifstream file{text_path, std::ios::binary};
+        const std::string content{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+
+        auto table = std::make_unique<Table>();
+        const char* first = content.data();
+        const char* last = content.data() + content.size();
+        for (double& value : *table)
+            first = std::from_chars(first, last, value).ptr + 1;
+        return table;
+    };
+
+    BENCHMARK("startup - read binary")
+    {
+        std::ifstream file{binary_path, std::ios::binary};
+        file.seekg(Mapped::payload_offset);
+
+        auto table = std::make_unique<Table>();
+        file.read(reinterpret_cast<char*>(table->begin()), N * sizeof(double));
+        return table;
+    };
+
+    BENCHMARK("startup - mapped_array (header)")
+    {
+        return Mapped::mapped_array<const double, N>{binary_path, {.verify = Mapped::Verify::header}}[N / 2];
+    };
+
+    BENCHMARK("startup - mapped_array (checksum)")
+    {
+        return Mapped::mapped_array<const double, N>{binary_path}[N / 2];
+    };
+
+    BENCHMARK("startup + full scan - mapped_array (header, sequential)")
+    {
+        const Mapped::mapped_array<const double, N> table{binary_path, {.access = Mapped::Access::sequential, .verify = Mapped::Verify::header}};
+        return std::accumulate(table.begin(), table.end(), 0.0);
+    };
+
+    std::filesystem::remove(text_path);
+    std::filesystem::remove(binary_path);
+}
+#endif
+
+//////////////////////////////////////
+// Fixed-capacity vector
+
+// storage is a union, so items are constructed on demand and
+// the whole vector stays trivially copyable when T is
+template <typename T, size_t N>
+class static_vector
+{
+    union
+    {
+        T items[N];
+    };
+
+    size_t count{};
+
+    [[noreturn]] static void throw_length_error()
+    {
+        throw std::length_error("static_vector - capacity exceeded");
+    }
+
+public:
+    using iterator = T*;
+    using const_iterator = const T*;
+    using value_type = T;
+    using reference = T&;
+    using const_reference = const T&;
+
+    constexpr static_vector() noexcept
+    {
+        // trivially copyable copies read all items - they must be initialized in constant evaluation
+        if consteval
+        {
+            if constexpr (std::is_trivial_v<T>)
+                std::fill_n(items, N, T{});
+        }
+    }
+
+    constexpr static_vector(std::initializer_list<T> il)
+        : static_vector{}
+    {
+        for (const T& item : il)
+            push_back(item);
+    }
+
+    constexpr static_vector(const static_vector&)
+        requires std::is_trivially_copy_constructible_v<T>
+    = default;
+
+    constexpr static_vector(const static_vector& other)
+        : static_vector{}
+    {
+        for (const T& item : other)
+            push_back(item);
+    }
+
+    constexpr static_vector(static_vector&&)
+        requires std::is_trivially_move_constructible_v<T>
+    = default;
+
+    constexpr static_vector(static_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+        : static_vector{}
+    {
+        for (T& item : other)
+            push_back(std::move(item));
+    }
+
+    constexpr static_vector& operator=(const static_vector&)
+        requires std::is_trivially_copy_assignable_v<T> && std::is_trivially_destructible_v<T>
+    = default;
+
+    constexpr static_vector& operator=(const static_vector& other)
+    {
+        if (this != &other)
+        {
+            clear();
+            for (const T& item : other)
+                push_back(item);
+        }
+        return *this;
+    }
+
+    constexpr static_vector& operator=(static_vector&&)
+        requires std::is_trivially_move_assignable_v<T> && std::is_trivially_destructible_v<T>
+    = default;
+
+    constexpr static_vector& operator=(static_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        if (this != &other)
+        {
+            clear();
+            for (T& item : other)
+                push_back(std::move(item));
+        }
+        return *this;
+    }
+
+    constexpr ~static_vector()
+        requires std::is_trivially_destructible_v<T>
+    = default;
+
+    constexpr ~static_vector()
+    {
+        clear();
+    }
+
+    constexpr size_t size() const
+    {
+        return count;
+    }
+
+    static constexpr size_t capacity()
+    {
+        return N;
+    }
+
+    constexpr bool empty() const
+    {
+        return count == 0;
+    }
+
+    constexpr iterator begin()
+    {
+        return items;
+    }
+
+    constexpr iterator end()
+    {
+        return items + count;
+    }
+
+    constexpr const_iterator begin() const
+    {
+        return items;
+    }
+
+    constexpr const_iterator end() const
+    {
+        return items + count;
+    }
+
+    template <typename TSelf>
+    constexpr auto& operator[](this TSelf&& self, size_t n)
+    {
+        return std::forward<TSelf>(self).begin()[n];
+    }
+
+    template <typename... TArgs>
+    constexpr T& emplace_back(TArgs&&... args)
+    {
+        if (count == N) [[unlikely]]
+            throw_length_error();
+
+        if constexpr (std::is_trivial_v<T>)
+            items[count] = T(std::forward<TArgs>(args)...);
+        else
+            std::construct_at(items + count, std::forward<TArgs>(args)...);
+
+        return items[count++];
+    }
+
+    constexpr void push_back(const T& item)
+    {
+        emplace_back(item);
+    }
+
+    constexpr void push_back(T&& item)
+    {
+        emplace_back(std::move(item));
+    }
+
+    constexpr void pop_back()
+    {
+        assert(count > 0);
+        std::destroy_at(items + --count);
+    }
+
+    constexpr iterator erase(const_iterator first, const_iterator last)
+    {
+        iterator gap = begin() + (first - begin());
+        iterator new_end = std::move(gap + (last - first), end(), gap);
+        std::destroy(new_end, end());
+        count = new_end - begin();
+        return gap;
+    }
+
+    constexpr iterator erase(const_iterator pos)
+    {
+        return erase(pos, pos + 1);
+    }
+
+    constexpr void clear()
+    {
+        std::destroy(begin(), end());
+        count = 0;
+    }
+
+    constexpr bool operator==(const static_vector& other) const
+        requires std::equality_comparable<T>
+    {
+        return std::equal(begin(), end(), other.begin(), other.end());
+    }
+
+    constexpr auto operator<=>(const static_vector& other) const
+        requires std::three_way_comparable<T>
+    {
+        return std::lexicographical_compare_three_way(begin(), end(), other.begin(), other.end());
+    }
+};
+
+static_assert(std::is_trivially_copyable_v<static_vector<int, 8>>);
+static_assert(!std::is_trivially_copyable_v<static_vector<std::string, 8>>);
+
+namespace StaticVectorConstexpr
+{
+    constexpr int sum_of_odd(int n)
+    {
+        static_vector<int, 16> items;
+        for (int i = 0; i < n; ++i)
+            items.push_back(i);
+
+        items.erase(std::remove_if(items.begin(), items.end(), [](int x) { return x % 2 == 0; }), items.end());
+        static_vector<int, 16> copy = items;
+
+        return std::accumulate(copy.begin(), copy.end(), 0);
+    }
+
+    static_assert(sum_of_odd(10) == 25);
+
+    constexpr size_t total_length()
+    {
+        static_vector<std::string, 4> words{"ala", "ma", "kota"};
+        words.erase(words.begin() + 1);
+        static_vector<std::string, 4> moved = std::move(words);
+
+        return moved[0].size() + moved[1].size() + moved.size();
+    }
+
+    static_assert(total_length() == 9);
+} // namespace StaticVectorConstexpr
+
+TEST_CASE("static_vector")
+{
+    static_vector<std::string, 4> words;
+    REQUIRE(words.empty());
+    REQUIRE(words.capacity() == 4);
+
+    words.push_back("one");
+    words.emplace_back(3, 'x');
+    words.push_back("three");
+
+    REQUIRE(words.size() == 3);
+    REQUIRE(words[1] == "xxx");
+
+    const auto& const_words = words;
+    static_assert(std::is_same_v<decltype(const_words[0]), const std::string&>);
+
+    SECTION("erase")
+    {
+        auto pos = words.erase(words.begin());
+        REQUIRE(*pos == "xxx");
+        REQUIRE(words == static_vector<std::string, 4>{"xxx", "three"});
+    }
+
+    SECTION("pop_back")
+    {
+        words.pop_back();
+        REQUIRE(words == static_vector<std::string, 4>{"one", "xxx"});
+    }
+
+    SECTION("capacity exceeded")
+    {
+        words.push_back("four");
+        REQUIRE_THROWS_AS(words.push_back("five"), std::length_error);
+        REQUIRE(words.size() == 4);
+    }
+
+    SECTION("comparisons")
+    {
+        REQUIRE(words < static_vector<std::string, 4>{"one", "xxx", "two"});
+        REQUIRE(words > static_vector<std::string, 4>{"one", "xxx"});
+    }
+}
+
+TEST_CASE("static_vector - benchmarks", "[.][benchmark]")
+{
+    for (int n : {1, 2, 4, 8, 16, 32, 64})
+    {
+        BENCHMARK("std::vector with reserve - " + std::to_string(n))
+        {
+            std::vector<int> items;
+            items.reserve(n);
+            for (int i = 0; i < n; ++i)
+                items.push_back(i);
+            return std::accumulate(items.begin(), items.end(), 0);
+        };
+
+        BENCHMARK("static_vector<int, 64> - " + std::to_string(n))
+        {
+            static_vector<int, 64> items;
+            for (int i = 0; i < n; ++i)
+                items.push_back(i);
+            return std::accumulate(items.begin(), items.end(), 0);
+        };
+    }
+}
+
+//////////////////////////////////////
+// Expression templates
+
+template <typename T>
+concept Addable = requires(T a, T b) {
+    { a + b } noexcept -> std::convertible_to<T>;
+};
+
+template <typename T>
+concept Arithmetic = Addable<T> && requires(T a, T b) {
+    { a - b } noexcept -> std::convertible_to<T>;
+    { a * b } noexcept -> std::convertible_to<T>;
+    { a / b } noexcept -> std::convertible_to<T>;
+};
+
+namespace Expr
+{
+    // leaf - refers to an array, which must outlive the expression
+    template <typename T, size_t N>
+    struct Ref
+    {
+        using is_expression = void;
+        using value_type = T;
+        static constexpr size_t size = N;
+
+        const Array<T, N>& array;
+
+        const T& operator[](size_t i) const
+        {
+            return array.items[i];
+        }
+    };
+
+    // leaf - scalar used for every index
+    template <typename T, size_t N>
+    struct Broadcast
+    {
+        using is_expression = void;
+        using value_type = T;
+        static constexpr size_t size = N;
+
+        T value;
+
+        const T& operator[](size_t) const
+        {
+            return value;
+        }
+    };
+
+    template <typename TOp, Expression TLeft, Expression TRight>
+        requires(TLeft::size == TRight::size)
+    struct Binary
+    {
+        using is_expression = void;
+        using value_type = typename TLeft::value_type;
+        static constexpr size_t size = TLeft::size;
+
+        TLeft left;
+        TRight right;
+
+        value_type operator[](size_t i) const
+        {
+            return TOp{}(left[i], right[i]);
+        }
+
+        // Array<T, N> result = a + b * c;
+        operator Array<value_type, size>() const
+        {
+            Array<value_type, size> result;
+            result = *this;
+            return result;
+        }
+    };
+
+    template <typename T>
+    struct IsArray : std::false_type
+    { };
+
+    template <typename T, size_t N>
+    struct IsArray<Array<T, N>> : std::true_type
+    { };
+
+    template <typename T>
+    concept Operand = (Expression<T> || IsArray<T>::value) && Arithmetic<typename T::value_type>;
+
+    template <typename T, size_t N>
+    Ref<T, N> as_expression(const Array<T, N>& array)
+    {
+        return {array};
+    }
+
+    // subexpressions are stored by value - they are temporaries of the full expression
+    template <Expression TExpr>
+    TExpr as_expression(const TExpr& expr)
+    {
+        return expr;
+    }
+
+    template <typename T>
+    using Expression_t = decltype(as_expression(std::declval<const T&>()));
+
+    template <typename TOp, Operand TLeft, Operand TRight>
+        requires std::same_as<typename TLeft::value_type, typename TRight::value_type>
+    auto make_binary(const TLeft& left, const TRight& right)
+    {
+        return Binary<TOp, Expression_t<TLeft>, Expression_t<TRight>>{as_expression(left), as_expression(right)};
+    }
+
+    template <typename TOp, Operand TLeft>
+    auto make_binary(const TLeft& left, const typename TLeft::value_type& right)
+    {
+        using TBroadcast = Broadcast<typename TLeft::value_type, Expression_t<TLeft>::size>;
+        return Binary<TOp, Expression_t<TLeft>, TBroadcast>{as_expression(left), TBroadcast{right}};
+    }
+
+    template <typename TOp, Operand TRight>
+    auto make_binary(const typename TRight::value_type& left, const TRight& right)
+    {
+        using TBroadcast = Broadcast<typename TRight::value_type, Expression_t<TRight>::size>;
+        return Binary<TOp, TBroadcast, Expression_t<TRight>>{TBroadcast{left}, as_expression(right)};
+    }
+
+    template <typename TLeft, typename TRight>
+    concept Operands = Operand<TLeft> || Operand<TRight>;
+
+    template <typename TLeft, typename TRight>
+        requires Operands<TLeft, TRight>
+    auto operator+(const TLeft& left, const TRight& right) -> decltype(make_binary<std::plus<>>(left, right))
+    {
+        return make_binary<std::plus<>>(left, right);
+    }
+
+    template <typename TLeft, typename TRight>
+        requires Operands<TLeft, TRight>
+    auto operator-(const TLeft& left, const TRight& right) -> decltype(make_binary<std::minus<>>(left, right))
+    {
+        return make_binary<std::minus<>>(left, right);
+    }
+
+    template <typename TLeft, typename TRight>
+        requires Operands<TLeft, TRight>
+    auto operator*(const TLeft& left, const TRight& right) -> decltype(make_binary<std::multiplies<>>(left, right))
+    {
+        return make_binary<std::multiplies<>>(left, right);
+    }
+
+    template <typename TLeft, typename TRight>
+        requires Operands<TLeft, TRight>
+    auto operator/(const TLeft& left, const TRight& right) -> decltype(make_binary<std::divides<>>(left, right))
+    {
+        return make_binary<std::divides<>>(left, right);
+    }
+
+    // independent partial sums - the loop vectorizes without reassociating a single accumulator
+    template <Operand TExpr>
+    auto sum(const TExpr& operand)
+    {
+        using T = typename TExpr::value_type;
+        constexpr size_t size = Expression_t<TExpr>::size;
+        constexpr size_t lanes = 8;
+
+        const auto expr = as_expression(operand);
+
+        if constexpr (size < lanes)
+        {
+            T total = expr[0];
+            for (size_t i = 1; i < size; ++i)
+                total = total + expr[i];
+            return total;
+        }
+        else
+        {
+            // accumulators start with the first items - T does not need a zero
+            auto partial = [&]<size_t... Lanes>(std::index_sequence<Lanes...>) {
+                return std::array<T, lanes>{expr[Lanes]...};
+            }(std::make_index_sequence<lanes>{});
+
+            size_t i = lanes;
+            for (; i + lanes <= size; i += lanes)
+                for (size_t lane = 0; lane < lanes; ++lane)
+                    partial[lane] = partial[lane] + expr[i + lane];
+
+            T total = partial[0];
+            for (size_t lane = 1; lane < lanes; ++lane)
+                total = total + partial[lane];
+            for (; i < size; ++i)
+                total = total + expr[i];
+
+            return total;
+        }
+    }
+
+    template <Operand TLeft, Operand TRight>
+    auto dot(const TLeft& left, const TRight& right)
+    {
+        return sum(left * right);
+    }
+
+    template <Operand TExpr>
+        requires std::floating_point<typename TExpr::value_type>
+    auto norm(const TExpr& operand)
+    {
+        return std::sqrt(dot(operand, operand));
+    }
+} // namespace Expr
+
+// Array lives in the global namespace - ADL finds the operators here
+using Expr::operator+;
+using Expr::operator-;
+using Expr::operator*;
+using Expr::operator/;
+
+namespace Naive
+{
+    template <typename T, size_t N, typename TOp>
+    Array<T, N> apply(const Array<T, N>& left, const Array<T, N>& right, TOp op)
+    {
+        Array<T, N> result;
+        for (size_t i = 0; i < N; ++i)
+            result[i] = op(left[i], right[i]);
+        return result;
+    }
+
+    template <typename T, size_t N>
+    Array<T, N> add(const Array<T, N>& left, const Array<T, N>& right)
+    {
+        return apply(left, right, std::plus<>{});
+    }
+
+    template <typename T, size_t N>
+    Array<T, N> multiply(const Array<T, N>& left, const Array<T, N>& right)
+    {
+        return apply(left, right, std::multiplies<>{});
+    }
+
+    template <typename T, size_t N>
+    T sum(const Array<T, N>& array)
+    {
+        return std::accumulate(array.begin(), array.end(), T{});
+    }
+} // namespace Naive
+
+// counts default constructions - each materialized Array<Tracked, N> adds N of them
+struct Tracked
+{
+    static inline int default_constructed = 0;
+
+    float value;
+
+    Tracked() noexcept
+        : value{}
+    {
+        ++default_constructed;
+    }
+
+    Tracked(float value) noexcept
+        : value{value}
+    { }
+
+    Tracked operator+(Tracked other) const noexcept
+    {
+        return value + other.value;
+    }
+
+    Tracked operator-(Tracked other) const noexcept
+    {
+        return value - other.value;
+    }
+
+    Tracked operator*(Tracked other) const noexcept
+    {
+        return value * other.value;
+    }
+
+    Tracked operator/(Tracked other) const noexcept
+    {
+        return value / other.value;
+    }
+};
+
+static_assert(Arithmetic<float>);
+static_assert(Arithmetic<Tracked>);
+static_assert(!Arithmetic<std::string>);
+
+TEST_CASE("expression templates")
+{
+    Array<float, 5> a{1, 2, 3, 4, 5};
+    Array<float, 5> b{2, 2, 2, 2, 2};
+    Array<float, 5> c{1, 0, 1, 0, 1};
+
+    SECTION("lazy evaluation")
+    {
+        auto expr = a + b * c;
+        static_assert(std::is_same_v<decltype(expr),
+            Expr::Binary<std::plus<>, Expr::Ref<float, 5>, Expr::Binary<std::multiplies<>, Expr::Ref<float, 5>, Expr::Ref<float, 5>>>>);
+
+        Array<float, 5> result = expr;
+        REQUIRE(result == Array<float, 5>{3, 2, 5, 4, 7});
+    }
+
+    SECTION("scalar broadcast")
+    {
+        Array<float, 5> result = (a - 1.0f) / 2.0f + 2.0f * c;
+        REQUIRE(result == Array<float, 5>{2, 0.5, 3, 1.5, 4});
+    }
+
+    SECTION("reductions")
+    {
+        REQUIRE(Expr::sum(a) == 15);
+        REQUIRE(Expr::sum(a * b) == 30);
+        REQUIRE(Expr::dot(a, c) == 9);
+        REQUIRE(Expr::norm(Array<double, 2>{3, 4}) == 5.0);
+
+        Array<int, 20> ones;
+        std::fill(ones.begin(), ones.end(), 1);
+        REQUIRE(Expr::sum(ones + ones) == 40);
+    }
+
+    SECTION("no temporaries are materialized")
+    {
+        Array<Tracked, 4> x{1.0f, 2.0f, 3.0f, 4.0f};
+        Array<Tracked, 4> y{1.0f, 1.0f, 1.0f, 1.0f};
+        Array<Tracked, 4> z{2.0f, 2.0f, 2.0f, 2.0f};
+
+        Tracked::default_constructed = 0;
+        Naive::add(x, Naive::multiply(y, z));
+        REQUIRE(Tracked::default_constructed == 2 * 4);
+
+        Tracked::default_constructed = 0;
+        Array<Tracked, 4> result = x + y * z - x / z;
+        REQUIRE(Tracked::default_constructed == 4); // only the result
+
+        Tracked::default_constructed = 0;
+        result = x * 2.0f + y;
+        REQUIRE(Tracked::default_constructed == 0);
+        REQUIRE(result[3].value == 9.0f);
+
+        Tracked::default_constructed = 0;
+        REQUIRE(Expr::dot(x + y, z).value == 28.0f);
+        REQUIRE(Expr::sum(Array<Tracked, 8>{1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 2.0f} * 2.0f).value == 18.0f);
+        REQUIRE(Tracked::default_constructed == 0);
+    }
+}
+
+TEST_CASE("expression templates - benchmarks", "[.][benchmark]")
+{
+    auto run = []<size_t N>(std::integral_constant<size_t, N>) {
+        auto a = std::make_unique<Array<float, N>>();
+        auto b = std::make_unique<Array<float, N>>();
+        auto c = std::make_unique<Array<float, N>>();
+        auto result = std::make_unique<Array<float, N>>();
+
+        std::mt19937 rnd{665};
+        std::uniform_real_distribution<float> distr(-1.0f, 1.0f);
+        for (size_t i = 0; i < N; ++i)
+            (*a)[i] = distr(rnd), (*b)[i] = distr(rnd), (*c)[i] = distr(rnd);
+
+        BENCHMARK("naive - a + b * c - N = " + std::to_string(N))
+        {
+            *result = Naive::add(*a, Naive::multiply(*b, *c));
+            return (*result)[0];
+        };
+
+        BENCHMARK("expression - a + b * c - N = " + std::to_string(N))
+        {
+            *result = *a + *b * *c;
+            return (*result)[0];
+        };
+
+        BENCHMARK("naive - sum(a * b) - N = " + std::to_string(N))
+        {
+            return Naive::sum(Naive::multiply(*a, *b));
+        };
+
+        BENCHMARK("expression - dot(a, b) - N = " + std::to_string(N))
+        {
+            return Expr::dot(*a, *b);
+        };
+    };
+
+    run(std::integral_constant<size_t, 4>{});
+    run(std::integral_constant<size_t, 16>{});
+    run(std::integral_constant<size_t, 256>{});
+    run(std::integral_constant<size_t, 4096>{});
+}
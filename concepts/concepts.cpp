@@ -1,8 +1,44 @@
+#include "generator.hpp"
+#include "intrusive_ptr.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <list>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <ranges>
+#include <set>
+#include <span>
+#include <stdexcept>
 #include <string>
+#include <system_error>
+#include <thread>
 #include <vector>
-#include <list>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 using namespace std::literals;
 
@@ -145,6 +181,7 @@ static_assert(Range<std::vector<int>>);
 static_assert(Range<std::string>);
 static_assert(not Range<int>);
 static_assert(Range<int[10]>);
+static_assert(Range<Coroutines::generator<int>>); // lazy - elements computed while iterating
 
 template <Range T>
 auto print(const T& container)
@@ -156,6 +193,345 @@ auto print(const T& container)
     std::cout << "\n";
 }
 
+//////////////////////////////////////
+// Reductions over ranges
+
+namespace Simd
+{
+    template <typename T>
+    struct Traits
+    {
+        static constexpr size_t width = 1; // no vector registers - scalar loop only
+    };
+
+#if defined(__SSE2__) || defined(_M_X64)
+    template <>
+    struct Traits<float>
+    {
+        using Register = __m128;
+        static constexpr size_t width = 4;
+
+        static Register load(const float* ptr) { return _mm_loadu_ps(ptr); }
+        static void store(float* ptr, Register r) { _mm_storeu_ps(ptr, r); }
+        static Register max(Register a, Register b) { return _mm_max_ps(a, b); }
+        static Register min(Register a, Register b) { return _mm_min_ps(a, b); }
+    };
+
+    template <>
+    struct Traits<double>
+    {
+        using Register = __m128d;
+        static constexpr size_t width = 2;
+
+        static Register load(const double* ptr) { return _mm_loadu_pd(ptr); }
+        static void store(double* ptr, Register r) { _mm_storeu_pd(ptr, r); }
+        static Register max(Register a, Register b) { return _mm_max_pd(a, b); }
+        static Register min(Register a, Register b) { return _mm_min_pd(a, b); }
+    };
+
+    template <>
+    struct Traits<std::int32_t>
+    {
+        using Register = __m128i;
+        static constexpr size_t width = 4;
+
+        static Register load(const std::int32_t* ptr) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr)); }
+        static void store(std::int32_t* ptr, Register r) { _mm_storeu_si128(reinterpret_cast<__m128i*>(ptr), r); }
+
+        static Register max(Register a, Register b) // SSE2 has no pmaxsd - compare & blend
+        {
+            const Register a_gt_b = _mm_cmpgt_epi32(a, b);
+            return _mm_or_si128(_mm_and_si128(a_gt_b, a), _mm_andnot_si128(a_gt_b, b));
+        }
+
+        static Register min(Register a, Register b)
+        {
+            const Register a_gt_b = _mm_cmpgt_epi32(a, b);
+            return _mm_or_si128(_mm_and_si128(a_gt_b, b), _mm_andnot_si128(a_gt_b, a));
+        }
+    };
+#endif
+
+    template <typename T>
+    inline constexpr bool has_registers = Traits<T>::width > 1;
+
+    struct Max
+    {
+        template <typename T>
+        static T scalar(T a, T b)
+        {
+            return a < b ? b : a;
+        }
+
+        template <typename T, typename TRegister>
+        static TRegister vector(TRegister a, TRegister b)
+        {
+            return Traits<T>::max(a, b);
+        }
+    };
+
+    struct Min
+    {
+        template <typename T>
+        static T scalar(T a, T b)
+        {
+            return b < a ? b : a;
+        }
+
+        template <typename T, typename TRegister>
+        static TRegister vector(TRegister a, TRegister b)
+        {
+            return Traits<T>::min(a, b);
+        }
+    };
+
+    template <typename Op, typename T, size_t N>
+    T horizontal(const T (&lanes)[N])
+    {
+        T result = lanes[0];
+        for (size_t i = 1; i < N; ++i)
+            result = Op::scalar(result, lanes[i]);
+        return result;
+    }
+
+    // one pass over data for all Ops; vertical reduction in registers + horizontal reduction of lanes at the end
+    // (result is unspecified if data contains NaNs)
+    template <typename... Ops, typename T>
+    std::array<T, sizeof...(Ops)> reduce(const T* data, size_t n)
+    {
+        assert(n > 0);
+
+        std::array<T, sizeof...(Ops)> result;
+        result.fill(data[0]);
+        size_t i = 1;
+
+        if constexpr (has_registers<T>)
+        {
+            using Simd = Traits<T>;
+
+            if (n >= Simd::width)
+            {
+                typename Simd::Register acc[sizeof...(Ops)]; // not std::array - vector types lose their attributes as template arguments
+                for (auto& reg : acc)
+                    reg = Simd::load(data);
+
+                for (i = Simd::width; i + Simd::width <= n; i += Simd::width)
+                {
+                    const auto chunk = Simd::load(data + i);
+                    size_t k = 0;
+                    (..., (acc[k] = Ops::template vector<T>(acc[k], chunk), ++k));
+                }
+
+                T lanes[Simd::width];
+                size_t k = 0;
+                (..., (Simd::store(lanes, acc[k]), result[k] = horizontal<Ops>(lanes), ++k));
+            }
+        }
+
+        for (; i < n; ++i)
+        {
+            size_t k = 0;
+            (..., (result[k] = Ops::scalar(result[k], data[i]), ++k));
+        }
+
+        return result;
+    }
+} // namespace Simd
+
+template <typename T>
+concept SimdReducibleRange = Range<T>
+    && std::contiguous_iterator<decltype(std::begin(std::declval<T&>()))>
+    && std::is_arithmetic_v<std::ranges::range_value_t<T>>;
+
+template <typename T>
+concept PointerRange = Range<T> && ver_3::Pointer<std::ranges::range_value_t<T>>;
+
+namespace ver_3
+{
+    template <Range TRange>
+    auto max_value(const TRange& rng)
+    {
+        assert(std::ranges::begin(rng) != std::ranges::end(rng));
+
+        if constexpr (SimdReducibleRange<TRange>)
+        {
+            return Simd::reduce<Simd::Max>(std::ranges::data(rng), std::ranges::size(rng))[0];
+        }
+        else
+        {
+            auto first = std::ranges::begin(rng);
+            auto result = *first;
+            for (auto it = ++first; it != std::ranges::end(rng); ++it)
+                result = result < *it ? *it : result;
+            return result;
+        }
+    }
+
+    template <PointerRange TRange>
+    auto max_value(const TRange& rng)
+    {
+        assert(std::ranges::begin(rng) != std::ranges::end(rng));
+
+        auto first = std::ranges::begin(rng);
+        auto max_ptr = *first;
+        for (auto it = ++first; it != std::ranges::end(rng); ++it)
+        {
+            assert(*it != nullptr);
+            if (*max_ptr < **it)
+                max_ptr = *it;
+        }
+        return *max_ptr;
+    }
+
+    template <Range TRange>
+    auto minmax(const TRange& rng)
+    {
+        assert(std::ranges::begin(rng) != std::ranges::end(rng));
+
+        using T = std::ranges::range_value_t<TRange>;
+
+        if constexpr (SimdReducibleRange<TRange>)
+        {
+            auto [min, max] = Simd::reduce<Simd::Min, Simd::Max>(std::ranges::data(rng), std::ranges::size(rng));
+            return std::pair{min, max};
+        }
+        else
+        {
+            // pairwise comparisons - 3 comparisons per 2 items
+            auto it = std::ranges::begin(rng);
+            const auto last = std::ranges::end(rng);
+            std::pair<T, T> result{*it, *it};
+
+            for (++it; it != last; ++it)
+            {
+                auto next = std::next(it);
+                if (next == last)
+                {
+                    if (*it < result.first)
+                        result.first = *it;
+                    else if (result.second < *it)
+                        result.second = *it;
+                    break;
+                }
+
+                // bound to const& - a prvalue or proxy item (std::vector<bool>, std::views::iota) lives until the end of the step
+                const auto& current = *it;
+                const auto& following = *next;
+                const bool swapped = following < current;
+                const auto& smaller = swapped ? following : current;
+                const auto& larger = swapped ? current : following;
+                if (smaller < result.first)
+                    result.first = smaller;
+                if (result.second < larger)
+                    result.second = larger;
+                it = next;
+            }
+
+            return result;
+        }
+    }
+
+    template <PointerRange TRange>
+    auto minmax(const TRange& rng)
+    {
+        assert(std::ranges::begin(rng) != std::ranges::end(rng));
+
+        auto first = std::ranges::begin(rng);
+        auto min_ptr = *first;
+        auto max_ptr = *first;
+        for (auto it = ++first; it != std::ranges::end(rng); ++it)
+        {
+            assert(*it != nullptr);
+            if (**it < *min_ptr)
+                min_ptr = *it;
+            else if (*max_ptr < **it)
+                max_ptr = *it;
+        }
+        return std::pair{*min_ptr, *max_ptr};
+    }
+} // namespace ver_3
+
+TEST_CASE("max_value & minmax for ranges")
+{
+    using namespace ver_3;
+
+    SECTION("SIMD path - arithmetic contiguous ranges")
+    {
+        std::vector<int> vec(1001);
+        std::iota(vec.begin(), vec.end(), -500);
+        std::ranges::shuffle(vec, std::mt19937{665});
+
+        CHECK(max_value(vec) == 500);
+        CHECK(minmax(vec) == std::pair{-500, 500});
+
+        float tab[] = {3.14f, -2.71f, 42.0f, 1.0f, 0.5f, 7.0f, -13.0f};
+        CHECK(max_value(tab) == 42.0f);
+        CHECK(minmax(tab) == std::pair{-13.0f, 42.0f});
+
+        std::vector<double> single = {665.0};
+        CHECK(minmax(single) == std::pair{665.0, 665.0});
+
+        std::vector<uint8_t> bytes = {4, 255, 0, 13}; // no SIMD traits - scalar loop
+        CHECK(minmax(bytes) == std::pair<uint8_t, uint8_t>{0, 255});
+    }
+
+    SECTION("pairwise fallback")
+    {
+        std::list<std::string> words = {"one", "two", "three", "four", "five"};
+        CHECK(max_value(words) == "two");
+        CHECK(minmax(words) == std::pair{"five"s, "two"s});
+
+        std::vector<bool> flags = {true, false, true, true}; // proxy items
+        CHECK(minmax(flags) == std::pair{false, true});
+
+        CHECK(minmax(std::views::iota(3, 10)) == std::pair{3, 9}); // prvalue items
+    }
+
+    SECTION("ranges of pointers are dereferenced")
+    {
+        int a = 42, b = 665, c = -1;
+        std::vector<int*> ptrs = {&a, &b, &c};
+        CHECK(max_value(ptrs) == 665);
+        CHECK(minmax(ptrs) == std::pair{-1, 665});
+
+        std::vector sps = {std::make_shared<int>(42), std::make_shared<int>(665)};
+        CHECK(max_value(sps) == 665);
+    }
+}
+
+TEST_CASE("max_value & minmax for ranges - benchmarks", "[.][benchmark]")
+{
+    std::vector<float> data(1'000'000);
+    std::ranges::generate(data, [gen = std::mt19937{42}, dist = std::uniform_real_distribution<float>{-1e6f, 1e6f}] mutable { return dist(gen); });
+
+    BENCHMARK("ver_3::max_value(range) - SIMD")
+    {
+        return ver_3::max_value(data);
+    };
+
+    BENCHMARK("std::ranges::max")
+    {
+        return std::ranges::max(data);
+    };
+
+    BENCHMARK("ver_3::minmax(range) - SIMD")
+    {
+        return ver_3::minmax(data);
+    };
+
+    BENCHMARK("std::ranges::minmax")
+    {
+        return std::ranges::minmax(data);
+    };
+
+    std::list<float> lst(data.begin(), data.end());
+
+    BENCHMARK("ver_3::minmax(list) - pairwise")
+    {
+        return ver_3::minmax(lst);
+    };
+}
+
 template <std::convertible_to<bool> Flag> // std::convertible_to<Flag, bool>
 void fun_with_flags(Flag flag)
 {}
@@ -315,6 +691,29 @@ void my_sort(std::ranges::bidirectional_range auto container)
     container.sort();
 }
 
+template <std::random_access_iterator It>
+void merge_sort(Executors::ThreadPool& pool, It first, It last, std::iter_difference_t<It> grain)
+{
+    if (last - first <= grain)
+    {
+        std::sort(first, last);
+        return;
+    }
+
+    const It middle = first + (last - first) / 2;
+    pool.join([&] { merge_sort(pool, first, middle, grain); }, [&] { merge_sort(pool, middle, last, grain); });
+    std::inplace_merge(first, middle, last);
+}
+
+// parallel merge sort - the halves are sorted by the workers of the pool, then merged in place
+void my_sort(Executors::ThreadPool& pool, std::ranges::random_access_range auto&& container)
+{
+    const auto size = std::ranges::distance(container);
+    const auto grain = std::max<decltype(size)>(4'096, size / static_cast<decltype(size)>(4 * pool.size()));
+
+    pool.run([&] { merge_sort(pool, std::ranges::begin(container), std::ranges::end(container), grain); });
+}
+
 TEST_CASE("sorting & subsuming")
 {
     std::vector vec = {42, 1, 665};
@@ -322,4 +721,855 @@ TEST_CASE("sorting & subsuming")
 
     std::list lst = {42, 1, 665};
     my_sort(lst);
-}
\ No newline at end of file
+}
+
+TEST_CASE("sorting - parallel")
+{
+    Executors::ThreadPool pool{4};
+
+    std::vector<int> data(100'000);
+    std::mt19937 rnd{665};
+    std::ranges::generate(data, [&] { return static_cast<int>(rnd() % 1'000); });
+
+    std::vector<int> expected = data;
+    std::ranges::sort(expected);
+
+    my_sort(pool, data);
+    REQUIRE(data == expected);
+
+    std::vector small = {42, 1, 665};
+    my_sort(pool, small);
+    REQUIRE(small == std::vector{1, 42, 665});
+}
+
+TEST_CASE("sorting - benchmarks", "[.][benchmark]")
+{
+    std::vector<int> data(1'000'000);
+    std::mt19937 rnd{665};
+    std::ranges::generate(data, [&] { return static_cast<int>(rnd()); });
+
+    // both include the copy of the unsorted data
+    BENCHMARK("std::sort")
+    {
+        std::vector<int> shuffled = data;
+        std::sort(shuffled.begin(), shuffled.end());
+        return shuffled;
+    };
+
+    // scaling - 1, 2, 4, ... up to hardware_concurrency workers
+    const size_t max_threads = std::max(1u, std::thread::hardware_concurrency());
+    for (size_t threads = 1; threads <= max_threads; threads *= 2)
+    {
+        Executors::ThreadPool pool{threads};
+
+        BENCHMARK("my_sort(pool) - " + std::to_string(threads) + " threads")
+        {
+            std::vector<int> shuffled = data;
+            my_sort(pool, shuffled);
+            return shuffled;
+        };
+    }
+}
+
+//////////////////////////////////////
+// Binary serialization driven by concepts
+
+namespace Binary
+{
+    template <typename T>
+    concept Scalar = std::is_arithmetic_v<T> || std::is_enum_v<T>;
+
+    template <typename T>
+    concept ContiguousTrivialRange = Range<T>
+        && std::ranges::contiguous_range<T>
+        && std::is_trivially_copyable_v<std::ranges::range_value_t<T>>;
+
+    template <typename T>
+    concept AssociativeContainer = Range<T> && requires {
+        typename T::key_type;
+        typename T::mapped_type;
+    };
+
+    template <typename T>
+    concept Aggregate = std::is_aggregate_v<T> && !Range<T>;
+
+    // aggregate without padding - the whole object is written with one memcpy
+    template <typename T>
+    concept RawAggregate = Aggregate<T> && std::is_trivially_copyable_v<T> && std::has_unique_object_representations_v<T>;
+
+    template <typename T>
+    struct IsPair : std::false_type
+    { };
+
+    template <typename T1, typename T2>
+    struct IsPair<std::pair<T1, T2>> : std::true_type
+    { };
+
+    // pair<const K, V> from associative containers is read as pair<K, V>
+    template <typename T>
+    struct Storable
+    {
+        using type = T;
+    };
+
+    template <typename K, typename V>
+    struct Storable<std::pair<const K, V>>
+    {
+        using type = std::pair<K, V>;
+    };
+
+    template <typename T>
+    using Storable_t = typename Storable<T>::type;
+
+    //////////////////////////////////////////////////
+    // structured binding "reflection" for aggregates (members must not be C-arrays)
+
+    struct AnyMember
+    {
+        template <typename T>
+        operator T() const; // only in unevaluated context
+    };
+
+    template <typename T, typename... TMembers>
+    constexpr size_t member_count()
+    {
+        if constexpr (requires { T{TMembers{}..., AnyMember{}}; })
+            return member_count<T, TMembers..., AnyMember>();
+        else
+            return sizeof...(TMembers);
+    }
+
+    template <typename TAggregate, typename F>
+    void for_each_member(TAggregate& obj, F&& f)
+    {
+        constexpr size_t count = member_count<std::remove_cvref_t<TAggregate>>();
+        static_assert(count >= 1 && count <= 6, "aggregates with 1 to 6 members are supported");
+
+        if constexpr (count == 1)
+        {
+            auto& [m1] = obj;
+            (f(m1));
+        }
+        else if constexpr (count == 2)
+        {
+            auto& [m1, m2] = obj;
+            (f(m1), f(m2));
+        }
+        else if constexpr (count == 3)
+        {
+            auto& [m1, m2, m3] = obj;
+            (f(m1), f(m2), f(m3));
+        }
+        else if constexpr (count == 4)
+        {
+            auto& [m1, m2, m3, m4] = obj;
+            (f(m1), f(m2), f(m3), f(m4));
+        }
+        else if constexpr (count == 5)
+        {
+            auto& [m1, m2, m3, m4, m5] = obj;
+            (f(m1), f(m2), f(m3), f(m4), f(m5));
+        }
+        else
+        {
+            auto& [m1, m2, m3, m4, m5, m6] = obj;
+            (f(m1), f(m2), f(m3), f(m4), f(m5), f(m6));
+        }
+    }
+
+    template <typename T>
+    inline constexpr bool always_false = false;
+
+    //////////////////////////////////////////////////
+    // format:
+    // - scalars & padding-free aggregates - raw bytes
+    // - contiguous ranges of trivially copyable items - uint64 count, padding to alignof(item), raw bytes
+    // - other ranges (associative containers too) - uint64 count, items (pairs as key & value)
+    // - other aggregates - members in declaration order
+
+    class Writer
+    {
+        std::vector<std::byte> buffer;
+
+        void write_bytes(const void* data, size_t size)
+        {
+            const auto* bytes = static_cast<const std::byte*>(data);
+            buffer.insert(buffer.end(), bytes, bytes + size);
+        }
+
+        void align(size_t alignment)
+        {
+            buffer.resize((buffer.size() + alignment - 1) / alignment * alignment);
+        }
+
+    public:
+        template <typename T>
+        void write(const T& value)
+        {
+            if constexpr (Scalar<T> || RawAggregate<T>)
+            {
+                write_bytes(&value, sizeof(T));
+            }
+            else if constexpr (ContiguousTrivialRange<T>)
+            {
+                using TItem = std::ranges::range_value_t<T>;
+
+                write(static_cast<std::uint64_t>(std::ranges::size(value)));
+                align(alignof(TItem));
+                write_bytes(std::ranges::data(value), std::ranges::size(value) * sizeof(TItem)); // single memcpy
+            }
+            else if constexpr (IsPair<T>::value)
+            {
+                write(value.first);
+                write(value.second);
+            }
+            else if constexpr (Range<T>)
+            {
+                write(static_cast<std::uint64_t>(std::ranges::distance(value)));
+                for (const auto& item : value)
+                    write(item);
+            }
+            else if constexpr (Aggregate<T>)
+            {
+                for_each_member(value, [this](const auto& member) { write(member); });
+            }
+            else
+                static_assert(always_false<T>, "type is not serializable");
+        }
+
+        std::span<const std::byte> bytes() const
+        {
+            return buffer;
+        }
+
+        std::vector<std::byte> release() &&
+        {
+            return std::move(buffer);
+        }
+    };
+
+    class Reader
+    {
+        std::span<const std::byte> data;
+        size_t pos{};
+
+        void read_bytes(void* dest, size_t size)
+        {
+            if (size > data.size() - pos)
+                throw std::out_of_range("Binary::Reader - unexpected end of data");
+            std::memcpy(dest, data.data() + pos, size);
+            pos += size;
+        }
+
+        void align(size_t alignment)
+        {
+            pos = std::min(data.size(), (pos + alignment - 1) / alignment * alignment);
+        }
+
+    public:
+        explicit Reader(std::span<const std::byte> data)
+            : data{data}
+        { }
+
+        template <typename T>
+        void read(T& value)
+        {
+            if constexpr (Scalar<T> || RawAggregate<T>)
+            {
+                read_bytes(&value, sizeof(T));
+            }
+            else if constexpr (ContiguousTrivialRange<T>)
+            {
+                using TItem = std::ranges::range_value_t<T>;
+
+                const auto count = read<std::uint64_t>();
+                align(alignof(TItem));
+
+                if constexpr (requires { value.resize(count); })
+                {
+                    if (count > (data.size() - pos) / sizeof(TItem))
+                        throw std::out_of_range("Binary::Reader - unexpected end of data");
+                    value.resize(count);
+                }
+                else if (count != std::ranges::size(value))
+                    throw std::length_error("Binary::Reader - size mismatch for fixed size range");
+
+                read_bytes(std::ranges::data(value), count * sizeof(TItem));
+            }
+            else if constexpr (IsPair<T>::value)
+            {
+                read(value.first);
+                read(value.second);
+            }
+            else if constexpr (Range<T>)
+            {
+                const auto count = read<std::uint64_t>();
+                value.clear();
+                for (std::uint64_t i = 0; i < count; ++i)
+                {
+                    Storable_t<std::ranges::range_value_t<T>> item{};
+                    read(item);
+                    value.insert(value.end(), std::move(item));
+                }
+            }
+            else if constexpr (Aggregate<T>)
+            {
+                for_each_member(value, [this](auto& member) { read(member); });
+            }
+            else
+                static_assert(always_false<T>, "type is not deserializable");
+        }
+
+        template <typename T>
+        T read()
+        {
+            T value{};
+            read(value);
+            return value;
+        }
+
+        // zero-copy view of a serialized contiguous range - valid as long as the underlying bytes
+        template <typename T>
+            requires std::is_trivially_copyable_v<T>
+        std::span<const T> view()
+        {
+            const auto count = read<std::uint64_t>();
+            align(alignof(T));
+
+            if (count > (data.size() - pos) / sizeof(T))
+                throw std::out_of_range("Binary::Reader - unexpected end of data");
+
+            const std::byte* first = data.data() + pos;
+            if (reinterpret_cast<std::uintptr_t>(first) % alignof(T) != 0)
+                throw std::runtime_error("Binary::Reader - misaligned data for zero-copy view");
+
+            pos += count * sizeof(T);
+            return {reinterpret_cast<const T*>(first), static_cast<size_t>(count)};
+        }
+    };
+
+    template <typename T>
+    std::vector<std::byte> serialize(const T& value)
+    {
+        Writer writer;
+        writer.write(value);
+        return std::move(writer).release();
+    }
+
+    template <typename T>
+    T deserialize(std::span<const std::byte> bytes)
+    {
+        return Reader{bytes}.read<T>();
+    }
+
+#if __has_include(<sys/mman.h>)
+    // read-only mapping of a file - page aligned, so zero-copy views of serialized arrays are aligned too
+    class MappedFile
+    {
+        void* address{};
+        size_t size{};
+
+    public:
+        explicit MappedFile(const std::filesystem::path& path)
+        {
+            const int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd == -1)
+                throw std::system_error(errno, std::generic_category(), "open " + path.string());
+
+            struct stat file_stat{};
+            if (::fstat(fd, &file_stat) == -1)
+            {
+                const int error = errno;
+                ::close(fd);
+                throw std::system_error(error, std::generic_category(), "fstat " + path.string());
+            }
+
+            size = static_cast<size_t>(file_stat.st_size);
+            if (size > 0)
+            {
+                address = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (address == MAP_FAILED)
+                {
+                    const int error = errno;
+                    ::close(fd);
+                    throw std::system_error(error, std::generic_category(), "mmap " + path.string());
+                }
+            }
+            ::close(fd);
+        }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        ~MappedFile()
+        {
+            if (address)
+                ::munmap(address, size);
+        }
+
+        std::span<const std::byte> bytes() const
+        {
+            return {static_cast<const std::byte*>(address), size};
+        }
+    };
+#endif
+} // namespace Binary
+
+struct Person
+{
+    std::string name;
+    uint8_t age;
+
+    auto operator<=>(const Person&) const = default;
+};
+
+struct Scene
+{
+    std::string title;
+    std::vector<BoundingBox> boxes;
+    std::map<std::string, Color> palette;
+    std::list<Person> people;
+};
+
+TEST_CASE("binary serialization")
+{
+    using namespace Binary;
+
+    static_assert(member_count<Person>() == 2);
+    static_assert(member_count<Color>() == 3);
+    static_assert(member_count<Scene>() == 4);
+    static_assert(RawAggregate<Color>);
+    static_assert(!RawAggregate<Person>);
+
+    SECTION("contiguous range of trivially copyable items - count + raw bytes")
+    {
+        const std::vector<double> data = {1.0, 2.5, -3.75};
+        const auto bytes = serialize(data);
+        REQUIRE(bytes.size() == sizeof(std::uint64_t) + 3 * sizeof(double));
+        REQUIRE(deserialize<std::vector<double>>(bytes) == data);
+    }
+
+    SECTION("aggregates")
+    {
+        const Person person{"Jan", 42};
+        REQUIRE(deserialize<Person>(serialize(person)) == person);
+
+        const Color color{255, 128, 0};
+        const auto restored = deserialize<Color>(serialize(color));
+        REQUIRE(std::tie(restored.r, restored.g, restored.b) == std::tie(color.r, color.g, color.b));
+    }
+
+    SECTION("associative & node based containers")
+    {
+        const std::map<int, std::string> dict = {{1, "one"}, {2, "two"}, {665, "evil"}};
+        REQUIRE(deserialize<std::map<int, std::string>>(serialize(dict)) == dict);
+
+        const std::set<std::string> words = {"ala", "ma", "kota"};
+        REQUIRE(deserialize<std::set<std::string>>(serialize(words)) == words);
+    }
+
+    SECTION("nested")
+    {
+        const Scene scene{"scene", {{1, 2}, {3, 4}}, {{"red", {255, 0, 0}}}, {{"Jan", 42}, {"Anna", 33}}};
+        const auto restored = deserialize<Scene>(serialize(scene));
+
+        REQUIRE(restored.title == scene.title);
+        REQUIRE(restored.boxes.size() == 2);
+        REQUIRE(restored.boxes[1].h == 4);
+        REQUIRE(restored.palette.at("red").r == 255);
+        REQUIRE(restored.people == scene.people);
+    }
+
+    SECTION("truncated data")
+    {
+        auto bytes = serialize(std::vector<int>{1, 2, 3});
+        bytes.pop_back();
+        REQUIRE_THROWS_AS(deserialize<std::vector<int>>(bytes), std::out_of_range);
+    }
+
+    SECTION("zero-copy view")
+    {
+        const std::vector<int> data = {1, 2, 3, 4};
+        Writer writer;
+        writer.write(std::string{"header"});
+        writer.write(data);
+
+        Reader reader{writer.bytes()};
+        REQUIRE(reader.read<std::string>() == "header");
+        std::span<const int> view = reader.view<int>();
+        REQUIRE(std::ranges::equal(view, data));
+        REQUIRE(static_cast<const void*>(view.data()) != static_cast<const void*>(data.data()));
+    }
+
+#if __has_include(<sys/mman.h>)
+    SECTION("mmap-backed zero-copy read")
+    {
+        const auto path = std::filesystem::temp_directory_path() / "binary_serialization_test.bin";
+        std::vector<double> data(10'000);
+        std::iota(data.begin(), data.end(), 0.5);
+        {
+            Writer writer;
+            writer.write(std::string{"doubles"});
+            writer.write(data);
+            std::ofstream file{path, std::ios::binary};
+            file.write(reinterpret_cast<const char*>(writer.bytes().data()), writer.bytes().size());
+        }
+
+        {
+            MappedFile mapped{path};
+            Reader reader{mapped.bytes()};
+            REQUIRE(reader.read<std::string>() == "doubles");
+            REQUIRE(std::ranges::equal(reader.view<double>(), data));
+        }
+        std::filesystem::remove(path);
+    }
+#endif
+}
+
+TEST_CASE("binary serialization - benchmarks", "[.][benchmark]")
+{
+    auto megabytes_per_second = [](size_t bytes, auto action) {
+        constexpr int repetitions = 10;
+        auto best = std::chrono::steady_clock::duration::max();
+        for (int i = 0; i < repetitions; ++i)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            action();
+            best = std::min(best, std::chrono::steady_clock::now() - start);
+        }
+        return static_cast<long>(bytes / 1e6 / std::chrono::duration<double>(best).count());
+    };
+
+    std::vector<double> doubles(8'000'000);
+    std::iota(doubles.begin(), doubles.end(), 0.0);
+    const auto doubles_bytes = Binary::serialize(doubles);
+
+    std::map<int, int> dict;
+    for (int i = 0; i < 1'000'000; ++i)
+        dict.emplace_hint(dict.end(), i, i);
+    const auto dict_bytes = Binary::serialize(dict);
+
+    std::vector<Person> people(1'000'000, Person{"Jan Kowalski", 42});
+    const auto people_bytes = Binary::serialize(people);
+
+    std::cout << "MB/s:"
+              << "\n  vector<double> - write:          " << megabytes_per_second(doubles_bytes.size(), [&] { return Binary::serialize(doubles); })
+              << "\n  vector<double> - read:           " << megabytes_per_second(doubles_bytes.size(), [&] { return Binary::deserialize<std::vector<double>>(doubles_bytes); })
+              << "\n  vector<double> - zero-copy view: " << megabytes_per_second(doubles_bytes.size(), [&] { return Binary::Reader{doubles_bytes}.view<double>(); })
+              << "\n  map<int, int> - write:           " << megabytes_per_second(dict_bytes.size(), [&] { return Binary::serialize(dict); })
+              << "\n  map<int, int> - read:            " << megabytes_per_second(dict_bytes.size(), [&] { return Binary::deserialize<std::map<int, int>>(dict_bytes); })
+              << "\n  vector<Person> - write:          " << megabytes_per_second(people_bytes.size(), [&] { return Binary::serialize(people); })
+              << "\n  vector<Person> - read:           " << megabytes_per_second(people_bytes.size(), [&] { return Binary::deserialize<std::vector<Person>>(people_bytes); })
+              << "\n";
+}
+
+namespace
+{
+    template <typename TCount = Intrusive::AtomicCount>
+    struct Number : Intrusive::RefCounted<Number<TCount>, TCount>
+    {
+        static inline std::atomic<int> alive{0};
+
+        int value;
+
+        explicit Number(int value)
+            : value{value}
+        {
+            ++alive;
+        }
+
+        Number(const Number& other)
+            : Intrusive::RefCounted<Number<TCount>, TCount>{other}
+            , value{other.value}
+        {
+            ++alive;
+        }
+
+        ~Number()
+        {
+            --alive;
+        }
+
+        bool operator<(const Number& other) const
+        {
+            return value < other.value;
+        }
+    };
+
+    template <typename TCount>
+    struct SharedValue : Intrusive::RefCounted<SharedValue<TCount>, TCount>
+    {
+        int value;
+
+        explicit SharedValue(int value)
+            : value{value}
+        { }
+
+        bool operator<(const SharedValue& other) const
+        {
+            return value < other.value;
+        }
+    };
+
+    // owns another biased-counted node - destroying it releases the child
+    struct BiasedNode : Intrusive::RefCounted<BiasedNode, Intrusive::BiasedCount>
+    {
+        static inline std::atomic<int> alive{0};
+
+        Intrusive::intrusive_ptr<BiasedNode> child;
+
+        explicit BiasedNode(Intrusive::intrusive_ptr<BiasedNode> child = nullptr)
+            : child{std::move(child)}
+        {
+            ++alive;
+        }
+
+        ~BiasedNode()
+        {
+            --alive;
+        }
+    };
+
+    struct PlainValue
+    {
+        int value;
+
+        bool operator<(const PlainValue& other) const
+        {
+            return value < other.value;
+        }
+    };
+} // namespace
+
+static_assert(ver_3::Pointer<Intrusive::intrusive_ptr<Number<>>>);
+static_assert(PointerRange<std::vector<Intrusive::intrusive_ptr<Number<>>>>);
+static_assert(sizeof(Intrusive::intrusive_ptr<Number<>>) == sizeof(Number<>*));
+
+TEST_CASE("intrusive_ptr")
+{
+    using Intrusive::intrusive_ptr;
+    using Intrusive::make_intrusive;
+
+    SECTION("max_value through the Pointer concept")
+    {
+        auto a = make_intrusive<Number<>>(42);
+        auto b = make_intrusive<Number<>>(665);
+
+        CHECK(ver_3::max_value(a, b).value == 665);
+        CHECK(a->use_count() == 1);
+    }
+
+    SECTION("max_value for a range of pointers")
+    {
+        std::vector<intrusive_ptr<Number<Intrusive::NonAtomicCount>>> numbers;
+        for (int n : {4, 665, 42})
+            numbers.push_back(make_intrusive<Number<Intrusive::NonAtomicCount>>(n));
+
+        CHECK(ver_3::max_value(numbers).value == 665);
+    }
+
+    SECTION("copies share the object - the last owner destroys it")
+    {
+        {
+            auto ptr = make_intrusive<Number<>>(1);
+            auto copy = ptr;
+            auto moved = std::move(copy);
+
+            CHECK(ptr == moved);
+            CHECK(copy == nullptr);
+            CHECK(ptr->use_count() == 2);
+
+            ptr.reset();
+            CHECK(Number<>::alive == 1);
+        }
+
+        CHECK(Number<>::alive == 0);
+    }
+
+    SECTION("detach & adopt")
+    {
+        auto ptr = make_intrusive<Number<>>(1);
+        Number<>* raw = ptr.detach();
+
+        intrusive_ptr<Number<>> adopted{raw, false};
+        CHECK(adopted->use_count() == 1);
+    }
+
+    SECTION("copied objects get their own count")
+    {
+        auto ptr = make_intrusive<Number<>>(1);
+        auto other = make_intrusive<Number<>>(*ptr);
+
+        CHECK(ptr->use_count() == 1);
+        CHECK(other->use_count() == 1);
+    }
+}
+
+TEST_CASE("intrusive_ptr - biased count across threads")
+{
+    using Intrusive::intrusive_ptr;
+    using Intrusive::make_intrusive;
+    using BiasedNumber = Number<Intrusive::BiasedCount>;
+
+    SECTION("references released by other threads are merged by the owner")
+    {
+        auto ptr = make_intrusive<BiasedNumber>(1);
+
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 8; ++i)
+        {
+            threads.emplace_back([copy = ptr]() mutable {
+                auto local = copy;
+                copy.reset();
+            });
+        }
+
+        for (auto& thd : threads)
+            thd.join();
+
+        CHECK(BiasedNumber::alive == 1);
+
+        ptr.reset();
+        CHECK(BiasedNumber::alive == 0);
+    }
+
+    SECTION("the last reference is released by another thread")
+    {
+        auto ptr = make_intrusive<BiasedNumber>(1);
+        std::thread{[moved = std::move(ptr)]() mutable { moved.reset(); }}.join();
+
+        CHECK(BiasedNumber::alive == 1); // deferred to the owner
+
+        Intrusive::process_deferred_releases();
+        CHECK(BiasedNumber::alive == 0);
+    }
+
+    SECTION("the owner thread exits first")
+    {
+        intrusive_ptr<BiasedNumber> ptr;
+        std::thread{[&ptr] { ptr = make_intrusive<BiasedNumber>(1); }}.join();
+
+        auto copy = ptr;
+        ptr.reset();
+        CHECK(BiasedNumber::alive == 1);
+
+        copy.reset();
+        CHECK(BiasedNumber::alive == 0);
+    }
+
+    SECTION("the owner thread exits first - the destroyed object releases a nested pointer")
+    {
+        intrusive_ptr<BiasedNode> ptr;
+        std::thread{[&ptr] { ptr = make_intrusive<BiasedNode>(make_intrusive<BiasedNode>()); }}.join();
+
+        auto copy = ptr;
+        ptr.reset();
+        CHECK(BiasedNode::alive == 2);
+
+        copy.reset(); // the child is released on the queue of the exited owner
+        CHECK(BiasedNode::alive == 0);
+    }
+
+    SECTION("many threads copying & releasing")
+    {
+        std::vector<intrusive_ptr<BiasedNumber>> numbers;
+        for (int n = 0; n < 100; ++n)
+            numbers.push_back(make_intrusive<BiasedNumber>(n));
+
+        std::atomic<int> wrong_results{0}; // Catch2 assertions are not thread safe - checked after join()
+
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 4; ++i)
+        {
+            threads.emplace_back([copies = numbers, &wrong_results]() mutable {
+                for (int n = 0; n < 100; ++n)
+                {
+                    std::vector<intrusive_ptr<BiasedNumber>> local = copies;
+                    if (ver_3::max_value(local).value != 99)
+                        ++wrong_results;
+                }
+                copies.clear();
+            });
+        }
+
+        for (auto& thd : threads)
+            thd.join();
+
+        CHECK(wrong_results == 0);
+
+        numbers.clear();
+        Intrusive::process_deferred_releases();
+        CHECK(BiasedNumber::alive == 0);
+    }
+}
+
+TEST_CASE("intrusive_ptr - benchmarks", "[.][benchmark]")
+{
+    constexpr int size = 100'000;
+
+    // libstdc++ counts shared_ptr references non-atomically until the first thread is started
+    std::thread{[] { }}.join();
+
+    // increasing values - max_value copies the pointer on every element
+    auto fill = [](auto make) {
+        std::vector<decltype(make(0))> pointers;
+        for (int n = 0; n < size; ++n)
+            pointers.push_back(make(n));
+        return pointers;
+    };
+
+    const auto shared = fill([](int n) { return std::make_shared<PlainValue>(n); });
+    const auto atomic = fill([](int n) { return Intrusive::make_intrusive<SharedValue<Intrusive::AtomicCount>>(n); });
+    const auto non_atomic = fill([](int n) { return Intrusive::make_intrusive<SharedValue<Intrusive::NonAtomicCount>>(n); });
+    const auto biased = fill([](int n) { return Intrusive::make_intrusive<SharedValue<Intrusive::BiasedCount>>(n); });
+
+    BENCHMARK("max_value - std::shared_ptr")
+    {
+        return ver_3::max_value(shared).value;
+    };
+
+    BENCHMARK("max_value - intrusive_ptr<AtomicCount>")
+    {
+        return ver_3::max_value(atomic).value;
+    };
+
+    BENCHMARK("max_value - intrusive_ptr<NonAtomicCount>")
+    {
+        return ver_3::max_value(non_atomic).value;
+    };
+
+    BENCHMARK("max_value - intrusive_ptr<BiasedCount>")
+    {
+        return ver_3::max_value(biased).value;
+    };
+
+    BENCHMARK("copy vector - std::shared_ptr")
+    {
+        return std::vector(shared);
+    };
+
+    BENCHMARK("copy vector - intrusive_ptr<AtomicCount>")
+    {
+        return std::vector(atomic);
+    };
+
+    BENCHMARK("copy vector - intrusive_ptr<NonAtomicCount>")
+    {
+        return std::vector(non_atomic);
+    };
+
+    BENCHMARK("copy vector - intrusive_ptr<BiasedCount>")
+    {
+        return std::vector(biased);
+    };
+
+    BENCHMARK("make - std::make_shared")
+    {
+        return std::make_shared<PlainValue>(42);
+    };
+
+    BENCHMARK("make - make_intrusive<AtomicCount>")
+    {
+        return Intrusive::make_intrusive<SharedValue<Intrusive::AtomicCount>>(42);
+    };
+}
@@ -0,0 +1,94 @@
+#include "intrusive_ptr.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace Intrusive::Details
+{
+    namespace
+    {
+        class QueueRegistry
+        {
+            std::mutex mutex;
+            std::vector<std::unique_ptr<DeferredQueue>> queues;
+
+        public:
+            static QueueRegistry& instance()
+            {
+                static QueueRegistry registry;
+                return registry;
+            }
+
+            DeferredQueue* create()
+            {
+                std::lock_guard lock{mutex};
+                return queues.emplace_back(std::make_unique<DeferredQueue>()).get();
+            }
+        };
+
+        // merges everything left in the queue when the owner thread exits
+        struct QueueCloser
+        {
+            DeferredQueue* queue = nullptr;
+
+            ~QueueCloser()
+            {
+                {
+                    std::lock_guard lock{queue->mutex};
+                    queue->closed = true;
+                }
+
+                process(*queue);
+                this_thread_queue = nullptr;
+            }
+        };
+    } // namespace
+
+    DeferredQueue* create_this_thread_queue()
+    {
+        // registry first - it is destroyed after the closers of all threads
+        DeferredQueue* queue = QueueRegistry::instance().create();
+
+        thread_local QueueCloser closer;
+        closer.queue = queue;
+
+        return this_thread_queue = queue;
+    }
+
+    void process(DeferredQueue& queue) noexcept
+    {
+        const BiasedCount* objects;
+        {
+            std::lock_guard lock{queue.mutex};
+            objects = std::exchange(queue.objects, nullptr);
+            queue.pending.store(false, std::memory_order_relaxed);
+        }
+
+        while (objects)
+        {
+            const BiasedCount* object = std::exchange(objects, objects->next_deferred);
+            object->merge(); // may destroy the object
+        }
+    }
+
+    void defer(DeferredQueue& queue, const BiasedCount& count) noexcept
+    {
+        bool closed;
+        {
+            std::lock_guard lock{queue.mutex};
+
+            closed = queue.closed;
+            if (!closed)
+            {
+                count.next_deferred = queue.objects;
+                queue.objects = &count;
+                queue.pending.store(true, std::memory_order_relaxed);
+            }
+        }
+
+        // the owner is gone - its biased count does not change anymore;
+        // merged outside the lock - the destroyed object may release references deferred to the same queue
+        if (closed)
+            count.merge();
+    }
+} // namespace Intrusive::Details
@@ -0,0 +1,406 @@
+#ifndef INTRUSIVE_PTR_HPP
+#define INTRUSIVE_PTR_HPP
+
+#include <atomic>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <utility>
+
+// Reference counted pointer with the count stored in the object - no control block, one allocation.
+//
+//   class Document : public Intrusive::RefCounted<Document> { ... };
+//   Intrusive::intrusive_ptr<Document> doc = Intrusive::make_intrusive<Document>(args...);
+//
+// Any type works with intrusive_ptr if intrusive_ptr_add_ref(const T*) & intrusive_ptr_release(const T*)
+// are found by ADL. RefCounted<T, TCount> provides them for one of the counting policies:
+//   AtomicCount    - thread safe (default)
+//   NonAtomicCount - objects shared within a single thread only
+//   BiasedCount    - biased reference counting: the owner (creating) thread counts non-atomically,
+//                    other threads use an atomic shared count; a release of an owner-counted reference
+//                    by another thread is deferred to the owner thread, which merges both counts
+//                    (on its next release, process_deferred_releases() or its exit)
+
+namespace Intrusive
+{
+    //////////////////////////////////////
+    // counting policies - release() returns true when the object has to be destroyed
+
+    class AtomicCount
+    {
+        mutable std::atomic<uint32_t> count{0};
+
+    public:
+        void add_ref() const noexcept
+        {
+            count.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        bool release() const noexcept
+        {
+            return count.fetch_sub(1, std::memory_order_acq_rel) == 1;
+        }
+
+        uint32_t use_count() const noexcept
+        {
+            return count.load(std::memory_order_relaxed);
+        }
+    };
+
+    class NonAtomicCount
+    {
+        mutable uint32_t count = 0;
+
+    public:
+        void add_ref() const noexcept
+        {
+            ++count;
+        }
+
+        bool release() const noexcept
+        {
+            return --count == 0;
+        }
+
+        uint32_t use_count() const noexcept
+        {
+            return count;
+        }
+    };
+
+    class BiasedCount;
+
+    namespace Details
+    {
+        // releases deferred to an owner thread - never deallocated before the static destruction,
+        // so objects can refer to the queue of a thread that has already exited
+        struct DeferredQueue
+        {
+            std::mutex mutex;
+            const BiasedCount* objects = nullptr; // linked through BiasedCount::next_deferred - queuing never allocates
+            std::atomic<bool> pending{false};
+            bool closed = false; // the owner thread exited - deferred releases are merged by the releasing thread
+        };
+
+        inline constinit thread_local DeferredQueue* this_thread_queue = nullptr;
+
+        DeferredQueue* create_this_thread_queue();
+
+        inline DeferredQueue* owner_queue() noexcept
+        {
+            DeferredQueue* queue = this_thread_queue;
+            if (queue == nullptr) [[unlikely]]
+                queue = create_this_thread_queue();
+            return queue;
+        }
+
+        void process(DeferredQueue& queue) noexcept;
+        void defer(DeferredQueue& queue, const BiasedCount& count) noexcept;
+    } // namespace Details
+
+    class BiasedCount
+    {
+    public:
+        using Destroyer = void (*)(const BiasedCount*) noexcept;
+
+        explicit BiasedCount(Destroyer destroyer)
+            : owner{Details::owner_queue()}
+            , destroyer{destroyer}
+        { }
+
+        BiasedCount(const BiasedCount&) = delete;
+        BiasedCount& operator=(const BiasedCount&) = delete;
+
+        void add_ref() const noexcept
+        {
+            if (uses_biased())
+                ++biased;
+            else
+                shared.fetch_add(one, std::memory_order_relaxed);
+        }
+
+        bool release() const noexcept
+        {
+            if (owner == Details::this_thread_queue && owner->pending.load(std::memory_order_relaxed)) [[unlikely]]
+                Details::process(*owner);
+
+            if (uses_biased())
+            {
+                if (--biased > 0)
+                    return false;
+
+                // the owner dropped all its references - from now on only the shared count is used
+                merged_by_owner = true;
+                const int64_t previous = shared.fetch_or(merged, std::memory_order_acq_rel);
+                return count_of(previous) == 0 && !(previous & queued);
+            }
+
+            // a negative unmerged count - the released reference was counted by the owner;
+            // queued is set in the same step, so the object cannot be destroyed before the owner merges
+            int64_t current = shared.load(std::memory_order_relaxed);
+            int64_t next;
+            do
+            {
+                next = current - one;
+                if (!(next & merged) && count_of(next) < 0)
+                    next |= queued;
+            } while (!shared.compare_exchange_weak(current, next, std::memory_order_acq_rel, std::memory_order_relaxed));
+
+            if (next & merged)
+                return count_of(next) == 0 && !(next & queued);
+
+            if ((next & queued) && !(current & queued))
+                Details::defer(*owner, *this);
+
+            return false;
+        }
+
+    private:
+        friend void Details::process(Details::DeferredQueue&) noexcept;
+        friend void Details::defer(Details::DeferredQueue&, const BiasedCount&) noexcept;
+
+        static constexpr int64_t merged = 1;
+        static constexpr int64_t queued = 2;
+        static constexpr int64_t one = 4; // the count is stored above the flags
+
+        static constexpr int64_t count_of(int64_t value) noexcept
+        {
+            return value >> 2;
+        }
+
+        Details::DeferredQueue* owner;
+        Destroyer destroyer;
+        mutable uint32_t biased = 0;         // touched by the owner thread only
+        mutable bool merged_by_owner = false; // touched by the owner thread only
+        mutable std::atomic<int64_t> shared{0};
+        mutable const BiasedCount* next_deferred = nullptr; // an object is queued at most once (the queued flag)
+
+        bool uses_biased() const noexcept
+        {
+            return owner == Details::this_thread_queue && !merged_by_owner;
+        }
+
+        // adds the biased count to the shared one - called by the owner thread (or any thread once the owner exited)
+        void merge() const noexcept
+        {
+            if (!(shared.load(std::memory_order_acquire) & merged))
+            {
+                merged_by_owner = true;
+                shared.fetch_add(int64_t{biased} * one + merged, std::memory_order_acq_rel);
+                biased = 0;
+            }
+
+            const int64_t now = shared.fetch_and(~queued, std::memory_order_acq_rel) & ~queued;
+            if (count_of(now) == 0)
+                destroyer(this);
+        }
+    };
+
+    // merges releases of this thread's objects made by other threads
+    inline void process_deferred_releases() noexcept
+    {
+        if (Details::DeferredQueue* queue = Details::this_thread_queue)
+            Details::process(*queue);
+    }
+
+    //////////////////////////////////////
+    // RefCounted - base class storing the count
+
+    template <typename TDerived, typename TCount = AtomicCount>
+    class RefCounted : private TCount
+    {
+        static void destroy(const TCount* count) noexcept
+        {
+            delete static_cast<const TDerived*>(static_cast<const RefCounted*>(count));
+        }
+
+    public:
+        RefCounted() noexcept
+            requires std::default_initializable<TCount>
+        = default;
+
+        RefCounted()
+            requires std::constructible_from<TCount, void (*)(const TCount*) noexcept>
+            : TCount{&RefCounted::destroy}
+        { }
+
+        // copies are new objects - the count is not copied
+        RefCounted(const RefCounted&)
+            : RefCounted{}
+        { }
+
+        RefCounted& operator=(const RefCounted&) noexcept
+        {
+            return *this;
+        }
+
+        friend void intrusive_ptr_add_ref(const TDerived* ptr) noexcept
+        {
+            static_cast<const RefCounted*>(ptr)->TCount::add_ref();
+        }
+
+        friend void intrusive_ptr_release(const TDerived* ptr) noexcept
+        {
+            if (static_cast<const RefCounted*>(ptr)->TCount::release())
+                delete ptr;
+        }
+
+        uint32_t use_count() const noexcept
+            requires requires(const TCount& count) { count.use_count(); }
+        {
+            return TCount::use_count();
+        }
+
+    protected:
+        ~RefCounted() = default;
+    };
+
+    //////////////////////////////////////
+    // intrusive_ptr
+
+    template <typename T>
+    class intrusive_ptr
+    {
+        T* ptr = nullptr;
+
+        template <typename U>
+        friend class intrusive_ptr;
+
+    public:
+        using element_type = T;
+
+        constexpr intrusive_ptr() noexcept = default;
+
+        constexpr intrusive_ptr(std::nullptr_t) noexcept
+        { }
+
+        explicit intrusive_ptr(T* ptr, bool add_ref = true) noexcept
+            : ptr{ptr}
+        {
+            if (ptr && add_ref)
+                intrusive_ptr_add_ref(ptr);
+        }
+
+        intrusive_ptr(const intrusive_ptr& other) noexcept
+            : intrusive_ptr{other.ptr}
+        { }
+
+        template <typename U>
+            requires std::convertible_to<U*, T*>
+        intrusive_ptr(const intrusive_ptr<U>& other) noexcept
+            : intrusive_ptr{other.ptr}
+        { }
+
+        intrusive_ptr(intrusive_ptr&& other) noexcept
+            : ptr{std::exchange(other.ptr, nullptr)}
+        { }
+
+        template <typename U>
+            requires std::convertible_to<U*, T*>
+        intrusive_ptr(intrusive_ptr<U>&& other) noexcept
+            : ptr{std::exchange(other.ptr, nullptr)}
+        { }
+
+        intrusive_ptr& operator=(const intrusive_ptr& other) noexcept
+        {
+            intrusive_ptr{other}.swap(*this);
+            return *this;
+        }
+
+        intrusive_ptr& operator=(intrusive_ptr&& other) noexcept
+        {
+            intrusive_ptr{std::move(other)}.swap(*this);
+            return *this;
+        }
+
+        intrusive_ptr& operator=(std::nullptr_t) noexcept
+        {
+            reset();
+            return *this;
+        }
+
+        ~intrusive_ptr()
+        {
+            if (ptr)
+                intrusive_ptr_release(ptr);
+        }
+
+        void reset() noexcept
+        {
+            intrusive_ptr{}.swap(*this);
+        }
+
+        void reset(T* other) noexcept
+        {
+            intrusive_ptr{other}.swap(*this);
+        }
+
+        // releases the ownership without decrementing the count
+        [[nodiscard]] T* detach() noexcept
+        {
+            return std::exchange(ptr, nullptr);
+        }
+
+        void swap(intrusive_ptr& other) noexcept
+        {
+            std::swap(ptr, other.ptr);
+        }
+
+        T* get() const noexcept
+        {
+            return ptr;
+        }
+
+        T& operator*() const noexcept
+        {
+            return *ptr;
+        }
+
+        T* operator->() const noexcept
+        {
+            return ptr;
+        }
+
+        explicit operator bool() const noexcept
+        {
+            return ptr != nullptr;
+        }
+
+        template <typename U>
+        bool operator==(const intrusive_ptr<U>& other) const noexcept
+        {
+            return ptr == other.get();
+        }
+
+        template <typename U>
+        std::strong_ordering operator<=>(const intrusive_ptr<U>& other) const noexcept
+        {
+            return std::compare_three_way{}(ptr, other.get());
+        }
+
+        bool operator==(std::nullptr_t) const noexcept
+        {
+            return ptr == nullptr;
+        }
+    };
+
+    template <typename T, typename... TArgs>
+    intrusive_ptr<T> make_intrusive(TArgs&&... args)
+    {
+        return intrusive_ptr<T>{new T(std::forward<TArgs>(args)...)};
+    }
+} // namespace Intrusive
+
+template <typename T>
+struct std::hash<Intrusive::intrusive_ptr<T>>
+{
+    size_t operator()(const Intrusive::intrusive_ptr<T>& ptr) const noexcept
+    {
+        return std::hash<T*>{}(ptr.get());
+    }
+};
+
+#endif
@@ -0,0 +1,501 @@
+#include "event_waiters.hpp"
+#include "generator.hpp"
+#include "instrumentation.hpp"
+#include "task.hpp"
+
+#include <algorithm>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <numeric>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace Coroutines;
+
+namespace
+{
+    generator<int> iota(int n)
+    {
+        for (int i = 0; i < n; ++i)
+            co_yield i;
+    }
+
+    generator<std::string> words()
+    {
+        std::string word = "one";
+        co_yield word;          // lvalue - no copy
+        co_yield "two";         // converted to a temporary
+        co_yield std::string{"three"};
+    }
+
+    // depth-first traversal of a complete binary tree of the given depth - nested generators
+    generator<int> tree(int node, int depth)
+    {
+        if (depth == 0)
+            co_return;
+
+        co_yield elements_of(tree(2 * node, depth - 1));
+        co_yield node;
+        co_yield elements_of(tree(2 * node + 1, depth - 1));
+    }
+
+    generator<int> throwing(int after)
+    {
+        for (int i = 0; i < after; ++i)
+            co_yield i;
+        throw std::runtime_error{"generator failed"};
+    }
+
+    generator<int> nested_throwing()
+    {
+        co_yield -1;
+        co_yield elements_of(throwing(2));
+        co_yield 665; // not reached
+    }
+
+    struct Arena
+    {
+        size_t allocations = 0;
+        size_t deallocations = 0;
+    };
+
+    template <typename T>
+    struct CountingAllocator
+    {
+        using value_type = T;
+
+        Arena* arena;
+
+        explicit CountingAllocator(Arena& arena) noexcept
+            : arena{&arena}
+        { }
+
+        template <typename U>
+        CountingAllocator(const CountingAllocator<U>& other) noexcept
+            : arena{other.arena}
+        { }
+
+        // a matching ::operator new / ::operator delete pair
+        T* allocate(size_t n)
+        {
+            ++arena->allocations;
+            return static_cast<T*>(::operator new(n * sizeof(T)));
+        }
+
+        void deallocate(T* ptr, size_t n) noexcept
+        {
+            ++arena->deallocations;
+            ::operator delete(ptr, n * sizeof(T));
+        }
+    };
+
+    generator<int> iota(std::allocator_arg_t, const CountingAllocator<std::byte>&, int n)
+    {
+        for (int i = 0; i < n; ++i)
+            co_yield i;
+    }
+} // namespace
+
+static_assert(std::input_iterator<generator<int>::iterator>);
+static_assert(std::ranges::input_range<generator<int>>);
+static_assert(std::ranges::view<generator<int>>);
+static_assert(std::same_as<std::iter_value_t<generator<std::string>::iterator>, std::string>);
+
+TEST_CASE("generator - elements")
+{
+    SECTION("lazy sequence")
+    {
+        std::vector<int> numbers;
+        for (int n : iota(5))
+            numbers.push_back(n);
+
+        REQUIRE(numbers == std::vector{0, 1, 2, 3, 4});
+    }
+
+    SECTION("empty")
+    {
+        generator<int> empty = iota(0);
+        REQUIRE(empty.begin() == empty.end());
+    }
+
+    SECTION("lvalues & temporaries")
+    {
+        std::vector<std::string> result;
+        std::ranges::copy(words(), std::back_inserter(result));
+
+        REQUIRE(result == std::vector<std::string>{"one", "two", "three"});
+    }
+
+    SECTION("iterator algorithms")
+    {
+        generator<int> numbers = iota(101);
+        REQUIRE(std::accumulate(numbers.begin(), numbers.end(), 0) == 5'050);
+
+        generator<int> more = iota(100);
+        REQUIRE(*std::find_if(more.begin(), more.end(), [](int x) { return x * x > 50; }) == 8);
+    }
+
+    SECTION("views")
+    {
+        auto squares = iota(1'000'000) | std::views::transform([](int x) { return x * x; }) | std::views::take(4);
+
+        REQUIRE(std::ranges::equal(squares, std::vector{0, 1, 4, 9}));
+    }
+
+    SECTION("a generator destroyed before the end")
+    {
+        generator<int> numbers = iota(1'000);
+        auto it = numbers.begin();
+        ++it;
+
+        REQUIRE(*it == 1);
+    }
+}
+
+TEST_CASE("generator - nested generators")
+{
+    std::vector<int> nodes;
+    for (int node : tree(1, 3))
+        nodes.push_back(node);
+
+    REQUIRE(nodes == std::vector{4, 2, 5, 1, 6, 3, 7});
+
+    SECTION("deep recursion")
+    {
+        REQUIRE(std::ranges::distance(tree(1, 16)) == (1 << 16) - 1);
+    }
+}
+
+TEST_CASE("generator - exceptions")
+{
+    SECTION("thrown out of operator++")
+    {
+        std::vector<int> numbers;
+        auto consume = [&] {
+            for (int n : throwing(3))
+                numbers.push_back(n);
+        };
+
+        REQUIRE_THROWS_AS(consume(), std::runtime_error);
+        REQUIRE(numbers == std::vector{0, 1, 2});
+    }
+
+    SECTION("rethrown through the parent generator")
+    {
+        std::vector<int> numbers;
+        auto consume = [&] {
+            for (int n : nested_throwing())
+                numbers.push_back(n);
+        };
+
+        REQUIRE_THROWS_AS(consume(), std::runtime_error);
+        REQUIRE(numbers == std::vector{-1, 0, 1});
+    }
+}
+
+TEST_CASE("generator - frames")
+{
+    SECTION("frames are recycled - no heap allocation in the steady state")
+    {
+        for (int n : iota(1)) // warm up - the first frame comes from the heap
+            (void)n;
+
+        Instrumentation::Scope scope;
+
+        long sum = 0;
+        for (int i = 0; i < 100; ++i)
+            for (int n : iota(10))
+                sum += n;
+
+        REQUIRE(sum == 4'500);
+        REQUIRE(scope.counts().allocations() == 0);
+    }
+
+    SECTION("frames from an allocator")
+    {
+        Arena arena;
+
+        {
+            generator<int> numbers = iota(std::allocator_arg, CountingAllocator<std::byte>{arena}, 5);
+            REQUIRE(arena.allocations == 1);
+            REQUIRE(std::accumulate(numbers.begin(), numbers.end(), 0) == 10);
+        }
+
+        REQUIRE(arena.deallocations == 1);
+    }
+}
+
+TEST_CASE("generator - memory of accumulate")
+{
+    constexpr int size = 100'000;
+
+    SECTION("materialized vector")
+    {
+        Instrumentation::Scope scope;
+
+        std::vector<int> numbers(size);
+        std::iota(numbers.begin(), numbers.end(), 0);
+        const long sum = std::accumulate(numbers.begin(), numbers.end(), 0L);
+
+        REQUIRE(sum == long{size} * (size - 1) / 2);
+        REQUIRE(scope.counts().allocated_bytes() == size * sizeof(int));
+    }
+
+    SECTION("generator")
+    {
+        generator<int> warm_up = iota(size);
+
+        Instrumentation::Scope scope;
+
+        generator<int> numbers = iota(size);
+        const long sum = std::accumulate(numbers.begin(), numbers.end(), 0L);
+
+        REQUIRE(sum == long{size} * (size - 1) / 2);
+        REQUIRE(scope.counts().allocated_bytes() < frame_size_step * 4); // one frame - independent of size
+    }
+}
+
+namespace
+{
+    task<int> answer()
+    {
+        co_return 42;
+    }
+
+    task<int> twice(int& started)
+    {
+        ++started;
+        co_return 2 * co_await answer();
+    }
+
+    task<std::unique_ptr<std::string>> move_only()
+    {
+        co_return std::make_unique<std::string>("move-only");
+    }
+
+    task<void> failing()
+    {
+        throw std::runtime_error{"task failed"};
+        co_return;
+    }
+
+    task<long> sum_of_awaited(int count)
+    {
+        long sum = 0;
+        for (int i = 0; i < count; ++i)
+            sum += co_await answer(); // finishes synchronously - symmetric transfer back to this coroutine
+        co_return sum;
+    }
+
+    // posted jobs run when the test says so
+    struct QueueExecutor
+    {
+        std::vector<std::function<void()>> jobs;
+
+        template <typename F>
+        void post(F&& f)
+        {
+            jobs.emplace_back(std::forward<F>(f));
+        }
+
+        void run_all()
+        {
+            for (auto pending = std::exchange(jobs, {}); auto& job : pending)
+                job();
+        }
+    };
+
+    static_assert(Executor<QueueExecutor>);
+    static_assert(Executor<const InlineExecutor>);
+} // namespace
+
+TEST_CASE("task - lazy start & results")
+{
+    SECTION("the coroutine runs when the task is started")
+    {
+        int started = 0;
+        task<int> result = twice(started);
+        REQUIRE(started == 0);
+
+        result.start();
+
+        REQUIRE(started == 1);
+        REQUIRE(result.done());
+        REQUIRE(result.get() == 84);
+    }
+
+    SECTION("move-only results")
+    {
+        auto consumer = []() -> task<std::string> {
+            std::unique_ptr<std::string> text = co_await move_only();
+            co_return *text;
+        };
+
+        task<std::string> result = consumer();
+        result.start();
+
+        REQUIRE(result.get() == "move-only");
+    }
+
+    SECTION("exceptions are rethrown by co_await")
+    {
+        auto consumer = []() -> task<bool> {
+            try
+            {
+                co_await failing();
+            }
+            catch (const std::runtime_error&)
+            {
+                co_return true;
+            }
+            co_return false;
+        };
+
+        task<bool> result = consumer();
+        result.start();
+
+        REQUIRE(result.get());
+    }
+
+    SECTION("exceptions of a top-level task are rethrown by get()")
+    {
+        task<void> result = failing();
+        result.start();
+
+        REQUIRE_THROWS_AS(result.get(), std::runtime_error);
+    }
+
+    // optimized builds turn the transfers into tail calls - without optimizations GCC still nests them
+    SECTION("symmetric transfer - a chain of synchronously finished awaits")
+    {
+        task<long> result = sum_of_awaited(10'000);
+        result.start();
+
+        REQUIRE(result.get() == 420'000L);
+    }
+}
+
+TEST_CASE("event waiters")
+{
+    EventWaiters<std::string, int> waiters;
+
+    auto handler = [&](std::vector<std::string>& log) -> task<void> {
+        for (int i = 0; i < 2; ++i)
+        {
+            auto [text, number] = co_await waiters.next();
+            log.push_back(text + ":" + std::to_string(number));
+        }
+    };
+
+    SECTION("waiters are resumed by the emission - in order of waiting")
+    {
+        std::vector<std::string> log;
+        task<void> first = handler(log);
+        task<void> second = handler(log);
+        first.start();
+        second.start();
+
+        waiters.capture("one", 1).deliver();
+        REQUIRE(log == std::vector<std::string>{"one:1", "one:1"});
+
+        waiters.capture("two", 2).deliver();
+        REQUIRE(log == std::vector<std::string>{"one:1", "one:1", "two:2", "two:2"});
+        REQUIRE(first.done());
+        REQUIRE(second.done());
+    }
+
+    SECTION("no waiters - arguments are not copied")
+    {
+        Instrumentation::Scope scope;
+        waiters.capture(std::string(100, 'x'), 1).deliver();
+
+        REQUIRE(scope.counts().allocations() == 1); // the temporary only
+    }
+
+    SECTION("a destroyed waiting coroutine leaves the list")
+    {
+        std::vector<std::string> log;
+        {
+            task<void> waiting = handler(log);
+            waiting.start();
+            REQUIRE_FALSE(waiters.empty());
+        }
+
+        REQUIRE(waiters.empty());
+        waiters.capture("nobody", 0).deliver();
+        REQUIRE(log.empty());
+    }
+
+    SECTION("resumed by an executor - arguments outlive the emission")
+    {
+        QueueExecutor executor;
+        std::string received;
+
+        auto deferred = [&]() -> task<void> {
+            auto [text, number] = co_await waiters.next(executor);
+            received = text;
+        };
+
+        task<void> waiting = deferred();
+        waiting.start();
+
+        waiters.capture(std::string(64, 't'), 1).deliver(); // the temporary dies here
+        REQUIRE_FALSE(waiting.done());
+
+        executor.run_all();
+
+        REQUIRE(waiting.done());
+        REQUIRE(received == std::string(64, 't'));
+    }
+}
+
+TEST_CASE("generator - benchmarks", "[.][benchmark]")
+{
+    constexpr int size = 1'000'000;
+
+    BENCHMARK("accumulate - materialized vector")
+    {
+        std::vector<int> numbers(size);
+        std::iota(numbers.begin(), numbers.end(), 0);
+        return std::accumulate(numbers.begin(), numbers.end(), 0L);
+    };
+
+    BENCHMARK("accumulate - generator")
+    {
+        generator<int> numbers = iota(size);
+        return std::accumulate(numbers.begin(), numbers.end(), 0L);
+    };
+
+    BENCHMARK("accumulate - nested generators (depth 20)")
+    {
+        generator<int> nodes = tree(1, 20);
+        return std::accumulate(nodes.begin(), nodes.end(), 0L);
+    };
+
+    BENCHMARK("create & destroy - recycled frame")
+    {
+        return *iota(1).begin();
+    };
+
+    BENCHMARK("create & destroy - operator new")
+    {
+        auto frame = std::make_unique<std::byte[]>(128);
+        return frame.get();
+    };
+}
+
+TEST_CASE("task - benchmarks", "[.][benchmark]")
+{
+    BENCHMARK("co_await task - 1000 times")
+    {
+        task<long> result = sum_of_awaited(1'000);
+        result.start();
+        return result.get();
+    };
+}
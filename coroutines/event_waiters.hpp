@@ -0,0 +1,289 @@
+#ifndef EVENT_WAITERS_HPP
+#define EVENT_WAITERS_HPP
+
+#include <concepts>
+#include <coroutine>
+#include <cstddef>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// Coroutines suspended until the next emission of an event - the awaitable side of Signal<Signature>.
+//
+//   Coroutines::EventWaiters<std::string, int> waiters;
+//
+//   task<void> handler()
+//   {
+//       auto [text, number] = co_await waiters.next();      // resumed on the emitting thread
+//       auto [text, number] = co_await waiters.next(pool);  // resumed by pool.post(...)
+//   }
+//
+//   auto emission = waiters.capture(text, 42); // takes the current waiters, decay-copies the arguments once
+//   emission.deliver();                        // resumes them - also done by the destructor
+//
+// All waiters of an emission share one copy of the arguments (EventArguments keeps it alive), so
+// a waiter resumed later on another thread never refers to the emitter's - possibly temporary - arguments.
+// A waiter awaiting next() again while being resumed waits for the following emission.
+// Registration & emission are not synchronized - they have to happen on one thread (or under a lock).
+
+namespace Coroutines
+{
+    template <typename E>
+    concept Executor = requires(E& executor) { executor.post([] { }); };
+
+    // resumes the waiter in place - on the emitting thread
+    struct InlineExecutor
+    {
+        template <std::invocable F>
+        void post(F&& f) const
+        {
+            std::forward<F>(f)();
+        }
+    };
+
+    // arguments of an emission - shared by its waiters; tuple-like, so structured bindings work
+    template <typename... TArgs>
+    class EventArguments
+    {
+        std::shared_ptr<const std::tuple<TArgs...>> values;
+
+    public:
+        explicit EventArguments(std::shared_ptr<const std::tuple<TArgs...>> values) noexcept
+            : values{std::move(values)}
+        { }
+
+        template <size_t Index>
+        const std::tuple_element_t<Index, std::tuple<TArgs...>>& get() const noexcept
+        {
+            return std::get<Index>(*values);
+        }
+
+        const std::tuple<TArgs...>& as_tuple() const noexcept
+        {
+            return *values;
+        }
+    };
+
+    namespace Details
+    {
+        class WaiterList;
+
+        struct WaiterNode
+        {
+            WaiterNode* prev = nullptr;
+            WaiterNode* next = nullptr;
+            WaiterList* list = nullptr; // null - not waiting
+        };
+
+        // intrusive list of awaiters - the nodes live in the frames of the suspended coroutines
+        class WaiterList
+        {
+            WaiterNode* head = nullptr;
+            WaiterNode* tail = nullptr;
+
+        public:
+            WaiterList() = default;
+            WaiterList(const WaiterList&) = delete;
+            WaiterList& operator=(const WaiterList&) = delete;
+
+            ~WaiterList()
+            {
+                while (pop_front())
+                { }
+            }
+
+            bool empty() const noexcept
+            {
+                return head == nullptr;
+            }
+
+            void push_back(WaiterNode& node) noexcept
+            {
+                node.prev = tail;
+                node.next = nullptr;
+                node.list = this;
+                (tail ? tail->next : head) = &node;
+                tail = &node;
+            }
+
+            void remove(WaiterNode& node) noexcept
+            {
+                (node.prev ? node.prev->next : head) = node.next;
+                (node.next ? node.next->prev : tail) = node.prev;
+                node.prev = node.next = nullptr;
+                node.list = nullptr;
+            }
+
+            WaiterNode* pop_front() noexcept
+            {
+                WaiterNode* node = head;
+                if (node)
+                    remove(*node);
+                return node;
+            }
+
+            void splice_to(WaiterList& other) noexcept
+            {
+                while (WaiterNode* node = pop_front())
+                    other.push_back(*node);
+            }
+        };
+    } // namespace Details
+
+    template <typename... TArgs>
+    class EventWaiters
+    {
+        using Values = std::tuple<TArgs...>;
+
+        Details::WaiterList waiting;
+
+    public:
+        using Arguments = EventArguments<TArgs...>;
+
+        // waiters get copies of the arguments - false e.g. for std::ostream or std::unique_ptr
+        static constexpr bool copyable_arguments = (std::copy_constructible<TArgs> && ...);
+
+        class Emission;
+
+        class [[nodiscard]] NextAwaiter : private Details::WaiterNode
+        {
+            friend EventWaiters;
+            friend Emission;
+
+            using Post = void (*)(void* executor, std::coroutine_handle<> coroutine);
+
+            EventWaiters* owner;
+            Post post;
+            void* executor;
+            std::coroutine_handle<> coroutine;
+            std::shared_ptr<const Values> values;
+
+            NextAwaiter(EventWaiters& owner, Post post, void* executor) noexcept
+                : owner{&owner}
+                , post{post}
+                , executor{executor}
+            { }
+
+        public:
+            NextAwaiter(const NextAwaiter&) = delete;
+            NextAwaiter& operator=(const NextAwaiter&) = delete;
+
+            // a coroutine destroyed while waiting leaves the list
+            ~NextAwaiter()
+            {
+                if (list)
+                    list->remove(*this);
+            }
+
+            bool await_ready() const noexcept
+            {
+                return false;
+            }
+
+            void await_suspend(std::coroutine_handle<> awaiting) noexcept
+            {
+                coroutine = awaiting;
+                owner->waiting.push_back(*this);
+            }
+
+            Arguments await_resume() noexcept
+            {
+                return Arguments{std::move(values)};
+            }
+        };
+
+        class Emission
+        {
+            friend EventWaiters;
+
+            Details::WaiterList waiting;
+            std::shared_ptr<const Values> values;
+
+            template <typename... TValues>
+            explicit Emission(Details::WaiterList& waiters, TValues&&... args)
+            {
+                if (waiters.empty())
+                    return;
+
+                values = std::make_shared<Values>(std::forward<TValues>(args)...);
+                waiters.splice_to(waiting);
+            }
+
+        public:
+            Emission(const Emission&) = delete;
+            Emission& operator=(const Emission&) = delete;
+
+            ~Emission()
+            {
+                deliver();
+            }
+
+            // resumes every captured waiter - inline or by posting to its executor
+            void deliver()
+            {
+                while (Details::WaiterNode* node = waiting.pop_front())
+                {
+                    auto& awaiter = static_cast<NextAwaiter&>(*node);
+                    awaiter.values = waiting.empty() ? std::move(values) : values;
+
+                    if (awaiter.post)
+                        awaiter.post(awaiter.executor, awaiter.coroutine);
+                    else
+                        awaiter.coroutine.resume(); // the awaiter may be gone after this line
+                }
+            }
+        };
+
+        bool empty() const noexcept
+        {
+            return waiting.empty();
+        }
+
+        NextAwaiter next() noexcept
+        {
+            return NextAwaiter{*this, nullptr, nullptr};
+        }
+
+        template <Executor TExecutor>
+        NextAwaiter next(TExecutor& executor) noexcept
+        {
+            return NextAwaiter{*this,
+                [](void* executor, std::coroutine_handle<> coroutine) { static_cast<TExecutor*>(executor)->post([coroutine] { coroutine.resume(); }); },
+                std::addressof(executor)};
+        }
+
+        // takes the current waiters & decay-copies args - once, and only if anyone waits
+        template <typename... TValues>
+            requires std::constructible_from<Values, TValues&&...>
+        Emission capture(TValues&&... args)
+        {
+            return Emission{waiting, std::forward<TValues>(args)...};
+        }
+    };
+
+    template <typename Signature>
+    struct EventWaitersOf;
+
+    template <typename TResult, typename... TArgs>
+    struct EventWaitersOf<TResult(TArgs...)>
+    {
+        using type = EventWaiters<std::decay_t<TArgs>...>;
+    };
+
+    // EventWaiters for the parameters of a function signature - void(const std::string&, int) -> EventWaiters<std::string, int>
+    template <typename Signature>
+    using EventWaitersFor = typename EventWaitersOf<Signature>::type;
+} // namespace Coroutines
+
+template <typename... TArgs>
+struct std::tuple_size<Coroutines::EventArguments<TArgs...>> : std::integral_constant<size_t, sizeof...(TArgs)>
+{ };
+
+template <size_t Index, typename... TArgs>
+struct std::tuple_element<Index, Coroutines::EventArguments<TArgs...>>
+{
+    using type = const std::tuple_element_t<Index, std::tuple<TArgs...>>;
+};
+
+#endif
@@ -0,0 +1,101 @@
+#include "frame_allocator.hpp"
+
+#include <cstdint>
+
+namespace Coroutines::Details
+{
+    namespace
+    {
+        constexpr size_t size_classes = max_recycled_size / frame_size_step;
+
+        struct FreeFrame
+        {
+            FreeFrame* next;
+        };
+
+        // no dynamic initialization & no destructor - usable while other thread_locals are destroyed
+        struct FrameCache
+        {
+            FreeFrame* heads[size_classes];
+            uint32_t counts[size_classes];
+            bool registered;
+            bool closed;
+        };
+
+        constinit thread_local FrameCache cache{};
+
+        constexpr size_t size_class(size_t size) noexcept
+        {
+            return (size + frame_size_step - 1) / frame_size_step - 1;
+        }
+
+        constexpr size_t class_size(size_t index) noexcept
+        {
+            return (index + 1) * frame_size_step;
+        }
+
+        // releases the free lists when the thread exits
+        struct CacheCloser
+        {
+            ~CacheCloser()
+            {
+                cache.closed = true;
+
+                for (size_t index = 0; index < size_classes; ++index)
+                {
+                    while (FreeFrame* frame = cache.heads[index])
+                    {
+                        cache.heads[index] = frame->next;
+                        ::operator delete(frame, class_size(index));
+                    }
+                    cache.counts[index] = 0;
+                }
+            }
+        };
+
+        void register_closer()
+        {
+            thread_local CacheCloser closer;
+            cache.registered = true;
+        }
+    } // namespace
+
+    void* allocate_recycled(size_t size)
+    {
+        if (size > max_recycled_size)
+            return ::operator new(size);
+
+        const size_t index = size_class(size);
+        if (FreeFrame* frame = cache.heads[index])
+        {
+            cache.heads[index] = frame->next;
+            --cache.counts[index];
+            return frame;
+        }
+
+        return ::operator new(class_size(index));
+    }
+
+    void deallocate_recycled(void* block, size_t size) noexcept
+    {
+        if (size > max_recycled_size)
+        {
+            ::operator delete(block, size);
+            return;
+        }
+
+        const size_t index = size_class(size);
+
+        if (!cache.registered && !cache.closed)
+            register_closer();
+
+        if (cache.closed || cache.counts[index] == max_recycled_per_size)
+        {
+            ::operator delete(block, class_size(index));
+            return;
+        }
+
+        cache.heads[index] = ::new (block) FreeFrame{cache.heads[index]};
+        ++cache.counts[index];
+    }
+} // namespace Coroutines::Details
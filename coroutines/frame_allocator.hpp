@@ -0,0 +1,145 @@
+#ifndef FRAME_ALLOCATOR_HPP
+#define FRAME_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <memory>
+#include <new>
+
+// Allocation of coroutine frames - promise types derive from AllocatorAwarePromise.
+//
+//   generator<int> numbers(int n);                                         - recycled frame
+//   generator<int> numbers(std::allocator_arg_t, const TAlloc& alloc, int n) - frame allocated by alloc
+//
+// Recycled frames: a destroyed frame goes to a free list of the destroying thread (size classes of
+// frame_size_step bytes up to max_recycled_size), the next coroutine of that class reuses it -
+// creating & destroying coroutines in a loop does not touch the heap in the steady state.
+//
+// Layout of a frame: [frame][deallocate function][allocator copy - allocator_arg coroutines only]
+
+namespace Coroutines
+{
+    inline constexpr size_t frame_size_step = 64;
+    inline constexpr size_t max_recycled_size = 2'048;
+    inline constexpr size_t max_recycled_per_size = 64;
+
+    namespace Details
+    {
+        using Deallocate = void (*)(void* frame, size_t size) noexcept;
+
+        constexpr size_t align_up(size_t size, size_t alignment) noexcept
+        {
+            return (size + alignment - 1) / alignment * alignment;
+        }
+
+        constexpr size_t trailer_offset(size_t size) noexcept
+        {
+            return align_up(size, alignof(Deallocate));
+        }
+
+        inline Deallocate& trailer(void* frame, size_t size) noexcept
+        {
+            return *std::launder(reinterpret_cast<Deallocate*>(static_cast<std::byte*>(frame) + trailer_offset(size)));
+        }
+
+        // per-thread free lists - frame_allocator.cpp
+        void* allocate_recycled(size_t size);
+        void deallocate_recycled(void* block, size_t size) noexcept;
+
+        struct RecycledFrame
+        {
+            static size_t total_size(size_t size) noexcept
+            {
+                return trailer_offset(size) + sizeof(Deallocate);
+            }
+
+            static void* allocate(size_t size)
+            {
+                void* frame = allocate_recycled(total_size(size));
+                ::new (static_cast<std::byte*>(frame) + trailer_offset(size)) Deallocate{&RecycledFrame::deallocate};
+                return frame;
+            }
+
+            static void deallocate(void* frame, size_t size) noexcept
+            {
+                deallocate_recycled(frame, total_size(size));
+            }
+        };
+
+        template <typename TAlloc>
+        struct AllocatorFrame
+        {
+            struct alignas(__STDCPP_DEFAULT_NEW_ALIGNMENT__) Block
+            {
+                std::byte bytes[__STDCPP_DEFAULT_NEW_ALIGNMENT__];
+            };
+
+            using TBlockAlloc = typename std::allocator_traits<TAlloc>::template rebind_alloc<Block>;
+            using Traits = std::allocator_traits<TBlockAlloc>;
+
+            static size_t allocator_offset(size_t size) noexcept
+            {
+                return align_up(trailer_offset(size) + sizeof(Deallocate), alignof(TBlockAlloc));
+            }
+
+            static size_t block_count(size_t size) noexcept
+            {
+                return (allocator_offset(size) + sizeof(TBlockAlloc) + sizeof(Block) - 1) / sizeof(Block);
+            }
+
+            static TBlockAlloc* stored_allocator(void* frame, size_t size) noexcept
+            {
+                return std::launder(reinterpret_cast<TBlockAlloc*>(static_cast<std::byte*>(frame) + allocator_offset(size)));
+            }
+
+            static void* allocate(size_t size, const TAlloc& alloc)
+            {
+                TBlockAlloc block_alloc{alloc};
+                void* frame = std::to_address(Traits::allocate(block_alloc, block_count(size)));
+
+                ::new (static_cast<std::byte*>(frame) + trailer_offset(size)) Deallocate{&AllocatorFrame::deallocate};
+                ::new (static_cast<std::byte*>(frame) + allocator_offset(size)) TBlockAlloc{std::move(block_alloc)};
+                return frame;
+            }
+
+            static void deallocate(void* frame, size_t size) noexcept
+            {
+                TBlockAlloc* stored = stored_allocator(frame, size);
+                TBlockAlloc block_alloc{std::move(*stored)};
+                std::destroy_at(stored);
+
+                Traits::deallocate(block_alloc, static_cast<Block*>(frame), block_count(size));
+            }
+        };
+    } // namespace Details
+
+    // base of promise types - operator new & delete of the coroutine frame
+    class AllocatorAwarePromise
+    {
+    public:
+        static void* operator new(size_t size)
+        {
+            return Details::RecycledFrame::allocate(size);
+        }
+
+        // coroutine parameters (std::allocator_arg_t, const TAlloc&, ...) - the frame comes from the allocator
+        template <typename TAlloc, typename... TArgs>
+        static void* operator new(size_t size, std::allocator_arg_t, const TAlloc& alloc, const TArgs&...)
+        {
+            return Details::AllocatorFrame<TAlloc>::allocate(size, alloc);
+        }
+
+        // member coroutines - the object parameter comes first
+        template <typename TThis, typename TAlloc, typename... TArgs>
+        static void* operator new(size_t size, const TThis&, std::allocator_arg_t, const TAlloc& alloc, const TArgs&...)
+        {
+            return Details::AllocatorFrame<TAlloc>::allocate(size, alloc);
+        }
+
+        static void operator delete(void* frame, size_t size) noexcept
+        {
+            Details::trailer(frame, size)(frame, size);
+        }
+    };
+} // namespace Coroutines
+
+#endif
@@ -0,0 +1,266 @@
+#ifndef GENERATOR_HPP
+#define GENERATOR_HPP
+
+#include "frame_allocator.hpp"
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+// Lazy range produced by a coroutine - elements are computed when the iterator advances.
+//
+//   Coroutines::generator<int> iota(int n)
+//   {
+//       for (int i = 0; i < n; ++i)
+//           co_yield i;
+//   }
+//
+//   long sum = std::accumulate(numbers.begin(), numbers.end(), 0L); // no container materialized
+//
+// co_yield Coroutines::elements_of(other) yields the elements of a nested generator<T> - the nested
+// coroutine is resumed directly by the iterator & returns to its parent by symmetric transfer, so
+// recursion depth does not add a resume per level per element.
+//
+// The iterator is an input iterator with end() of the same type - generator<T> works with the
+// begin/end based algorithms & concepts as well as with std::ranges & views.
+
+namespace Coroutines
+{
+    template <typename TGenerator>
+    struct elements_of
+    {
+        TGenerator range;
+    };
+
+    template <typename TGenerator>
+    elements_of(TGenerator&&) -> elements_of<TGenerator&&>;
+
+    template <typename T>
+    class generator : public std::ranges::view_interface<generator<T>>
+    {
+    public:
+        using value_type = std::remove_cvref_t<T>;
+        using reference = const value_type&;
+
+        class promise_type;
+        class iterator;
+
+    private:
+        using handle = std::coroutine_handle<promise_type>;
+
+        struct FinalAwaiter
+        {
+            bool await_ready() const noexcept
+            {
+                return false;
+            }
+
+            std::coroutine_handle<> await_suspend(handle finished) noexcept
+            {
+                promise_type& promise = finished.promise();
+                if (promise.parent == nullptr)
+                    return std::noop_coroutine(); // back to the iterator
+
+                promise.root->leaf = promise.parent;
+                return handle::from_promise(*promise.parent);
+            }
+
+            void await_resume() const noexcept
+            { }
+        };
+
+        struct NestedAwaiter
+        {
+            generator nested;
+
+            bool await_ready() const noexcept
+            {
+                return !nested.coroutine;
+            }
+
+            std::coroutine_handle<> await_suspend(handle current) noexcept
+            {
+                promise_type& parent = current.promise();
+                promise_type& child = nested.coroutine.promise();
+
+                child.root = parent.root;
+                child.parent = &parent;
+                parent.root->leaf = &child;
+                return nested.coroutine;
+            }
+
+            void await_resume() const
+            {
+                if (nested.coroutine && nested.coroutine.promise().error)
+                    std::rethrow_exception(nested.coroutine.promise().error);
+            }
+        };
+
+    public:
+        class promise_type : public AllocatorAwarePromise
+        {
+            friend generator;
+
+            const value_type* value = nullptr; // set in the root - the current element of the innermost generator
+            promise_type* root = this;
+            promise_type* leaf = this; // the root only - the innermost running generator
+            promise_type* parent = nullptr;
+            std::exception_ptr error;  // nested generators only - rethrown in the parent
+
+        public:
+            generator get_return_object() noexcept
+            {
+                return generator{handle::from_promise(*this)};
+            }
+
+            std::suspend_always initial_suspend() const noexcept
+            {
+                return {};
+            }
+
+            FinalAwaiter final_suspend() const noexcept
+            {
+                return {};
+            }
+
+            std::suspend_always yield_value(const value_type& item) noexcept
+            {
+                root->value = std::addressof(item);
+                return {};
+            }
+
+            // a temporary lives until the coroutine is resumed
+            std::suspend_always yield_value(value_type&& item) noexcept
+            {
+                root->value = std::addressof(item);
+                return {};
+            }
+
+            NestedAwaiter yield_value(elements_of<generator&&> nested) noexcept
+            {
+                return NestedAwaiter{std::move(nested.range)};
+            }
+
+            NestedAwaiter yield_value(elements_of<generator&> nested) noexcept
+            {
+                return NestedAwaiter{std::move(nested.range)};
+            }
+
+            template <typename TAwaitable>
+            void await_transform(TAwaitable&&) = delete; // co_await is not allowed in a generator
+
+            void return_void() const noexcept
+            { }
+
+            void unhandled_exception()
+            {
+                if (parent == nullptr)
+                    throw; // out of the iterator's operator++
+
+                error = std::current_exception();
+            }
+        };
+
+        class iterator
+        {
+            friend generator;
+
+            handle coroutine; // the root
+
+            explicit iterator(handle coroutine) noexcept
+                : coroutine{coroutine}
+            { }
+
+            handle running() const noexcept
+            {
+                return coroutine && !coroutine.done() ? coroutine : handle{};
+            }
+
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = generator::value_type;
+            using difference_type = std::ptrdiff_t;
+            using reference = generator::reference;
+            using pointer = const value_type*;
+
+            iterator() = default;
+
+            reference operator*() const noexcept
+            {
+                return *coroutine.promise().value;
+            }
+
+            pointer operator->() const noexcept
+            {
+                return coroutine.promise().value;
+            }
+
+            iterator& operator++()
+            {
+                handle::from_promise(*coroutine.promise().leaf).resume();
+                return *this;
+            }
+
+            void operator++(int)
+            {
+                ++*this;
+            }
+
+            friend bool operator==(const iterator& lhs, const iterator& rhs) noexcept
+            {
+                return lhs.running() == rhs.running();
+            }
+
+            friend bool operator==(const iterator& it, std::default_sentinel_t) noexcept
+            {
+                return !it.running();
+            }
+        };
+
+        generator() noexcept = default;
+
+        generator(generator&& other) noexcept
+            : coroutine{std::exchange(other.coroutine, nullptr)}
+        { }
+
+        generator& operator=(generator&& other) noexcept
+        {
+            generator temp{std::move(other)};
+            std::swap(coroutine, temp.coroutine);
+            return *this;
+        }
+
+        ~generator()
+        {
+            if (coroutine)
+                coroutine.destroy();
+        }
+
+        // starts the coroutine - a generator can be iterated once, begin() of a finished generator returns end()
+        iterator begin()
+        {
+            if (coroutine && !coroutine.done())
+                handle::from_promise(*coroutine.promise().leaf).resume();
+            return iterator{coroutine};
+        }
+
+        iterator end() const noexcept
+        {
+            return iterator{};
+        }
+
+    private:
+        handle coroutine;
+
+        explicit generator(handle coroutine) noexcept
+            : coroutine{coroutine}
+        { }
+    };
+} // namespace Coroutines
+
+#endif
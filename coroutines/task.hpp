@@ -0,0 +1,225 @@
+#ifndef TASK_HPP
+#define TASK_HPP
+
+#include "frame_allocator.hpp"
+
+#include <coroutine>
+#include <exception>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+// Lazy asynchronous operation - the coroutine starts when the task is awaited (or start() is called).
+//
+//   Coroutines::task<int> answer() { co_return 42; }
+//
+//   Coroutines::task<void> run()
+//   {
+//       int value = co_await answer(); // runs answer(), resumes here when it finishes
+//   }
+//
+//   auto top = run();
+//   top.start();                       // top-level task - runs until its first suspension
+//
+// Awaiting a task & its completion use symmetric transfer - a chain of tasks that finish synchronously
+// does not grow the stack. Frames are recycled like those of generator<T> (frame_allocator.hpp).
+
+namespace Coroutines
+{
+    template <typename T = void>
+    class task;
+
+    namespace Details
+    {
+        class TaskPromiseBase : public AllocatorAwarePromise
+        {
+            std::coroutine_handle<> continuation; // the awaiting coroutine - none for a top-level task
+
+            struct FinalAwaiter
+            {
+                bool await_ready() const noexcept
+                {
+                    return false;
+                }
+
+                template <typename TPromise>
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<TPromise> finished) noexcept
+                {
+                    std::coroutine_handle<> continuation = finished.promise().continuation;
+                    return continuation ? continuation : std::noop_coroutine();
+                }
+
+                void await_resume() const noexcept
+                { }
+            };
+
+        public:
+            std::suspend_always initial_suspend() const noexcept
+            {
+                return {};
+            }
+
+            FinalAwaiter final_suspend() const noexcept
+            {
+                return {};
+            }
+
+            void set_continuation(std::coroutine_handle<> awaiting) noexcept
+            {
+                continuation = awaiting;
+            }
+        };
+
+        template <typename T>
+        class TaskPromise : public TaskPromiseBase
+        {
+            std::variant<std::monostate, T, std::exception_ptr> result;
+
+        public:
+            task<T> get_return_object() noexcept;
+
+            template <typename U = T>
+                requires std::convertible_to<U&&, T>
+            void return_value(U&& value) noexcept(std::is_nothrow_constructible_v<T, U&&>)
+            {
+                result.template emplace<1>(std::forward<U>(value));
+            }
+
+            void unhandled_exception() noexcept
+            {
+                result.template emplace<2>(std::current_exception());
+            }
+
+            T get_result()
+            {
+                if (result.index() == 2)
+                    std::rethrow_exception(std::get<2>(result));
+                return std::move(std::get<1>(result));
+            }
+        };
+
+        template <>
+        class TaskPromise<void> : public TaskPromiseBase
+        {
+            std::exception_ptr error;
+
+        public:
+            task<void> get_return_object() noexcept;
+
+            void return_void() const noexcept
+            { }
+
+            void unhandled_exception() noexcept
+            {
+                error = std::current_exception();
+            }
+
+            void get_result()
+            {
+                if (error)
+                    std::rethrow_exception(error);
+            }
+        };
+    } // namespace Details
+
+    template <typename T>
+    class [[nodiscard]] task
+    {
+        static_assert(!std::is_reference_v<T>, "task<T&> is not supported - use task<T*> or task<std::reference_wrapper<T>>");
+
+    public:
+        using promise_type = Details::TaskPromise<T>;
+        using value_type = T;
+
+    private:
+        using handle = std::coroutine_handle<promise_type>;
+
+        struct Awaiter
+        {
+            handle coroutine;
+
+            bool await_ready() const noexcept
+            {
+                return !coroutine || coroutine.done();
+            }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+            {
+                coroutine.promise().set_continuation(awaiting);
+                return coroutine;
+            }
+
+            T await_resume()
+            {
+                return coroutine.promise().get_result();
+            }
+        };
+
+    public:
+        task() noexcept = default;
+
+        task(task&& other) noexcept
+            : coroutine{std::exchange(other.coroutine, nullptr)}
+        { }
+
+        task& operator=(task&& other) noexcept
+        {
+            task temp{std::move(other)};
+            std::swap(coroutine, temp.coroutine);
+            return *this;
+        }
+
+        ~task()
+        {
+            if (coroutine)
+                coroutine.destroy();
+        }
+
+        Awaiter operator co_await() && noexcept
+        {
+            return Awaiter{coroutine};
+        }
+
+        // top-level task - runs the coroutine until its first suspension
+        void start()
+        {
+            coroutine.resume();
+        }
+
+        bool done() const noexcept
+        {
+            return !coroutine || coroutine.done();
+        }
+
+        // the result of a finished top-level task - rethrows its exception
+        T get()
+        {
+            return coroutine.promise().get_result();
+        }
+
+    private:
+        friend promise_type;
+
+        handle coroutine;
+
+        explicit task(handle coroutine) noexcept
+            : coroutine{coroutine}
+        { }
+    };
+
+    namespace Details
+    {
+        template <typename T>
+        task<T> TaskPromise<T>::get_return_object() noexcept
+        {
+            return task<T>{std::coroutine_handle<TaskPromise>::from_promise(*this)};
+        }
+
+        inline task<void> TaskPromise<void>::get_return_object() noexcept
+        {
+            return task<void>{std::coroutine_handle<TaskPromise>::from_promise(*this)};
+        }
+    } // namespace Details
+} // namespace Coroutines
+
+#endif
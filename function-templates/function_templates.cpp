@@ -1,9 +1,24 @@
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <cstring>
+#include <cstdlib>
 #include <functional>
 #include <iostream>
+#include <random>
+#include <ranges>
+#include <set>
 #include <string>
+#include <string_view>
 #include <vector>
 
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
 using namespace std::literals;
 
 template <typename T>
@@ -19,6 +34,66 @@ T max_value(T a, T b)
 //     return std::strcmp(cstr1, cstr2) < 0 ? cstr2 : cstr1;
 // }
 
+namespace Simd
+{
+#if defined(__SSE2__) || defined(_M_X64)
+    inline __m128i equal_bytes(const char* ptr1, const char* ptr2)
+    {
+        return _mm_cmpeq_epi8(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr1)),
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr2)));
+    }
+#endif
+
+    // strcmp-compatible result; lengths are known, so chunks are never read past the terminators
+    inline int compare(std::string_view str1, std::string_view str2)
+    {
+        const size_t length = std::min(str1.size(), str2.size());
+        const char* data1 = str1.data();
+        const char* data2 = str2.data();
+        size_t i = 0;
+
+#if defined(__SSE2__) || defined(_M_X64)
+        // 64 bytes per step while equal - the mismatching chunk is located by 16-byte steps below
+        for (; i + 64 <= length; i += 64)
+        {
+            const __m128i equal = _mm_and_si128(
+                _mm_and_si128(equal_bytes(data1 + i, data2 + i), equal_bytes(data1 + i + 16, data2 + i + 16)),
+                _mm_and_si128(equal_bytes(data1 + i + 32, data2 + i + 32), equal_bytes(data1 + i + 48, data2 + i + 48)));
+
+            if (_mm_movemask_epi8(equal) != 0xFFFF)
+                break;
+        }
+
+        for (; i + 16 <= length; i += 16)
+        {
+            const unsigned mismatch = ~static_cast<unsigned>(_mm_movemask_epi8(equal_bytes(data1 + i, data2 + i))) & 0xFFFFu;
+
+            if (mismatch != 0)
+            {
+                i += std::countr_zero(mismatch);
+                return static_cast<unsigned char>(data1[i]) - static_cast<unsigned char>(data2[i]);
+            }
+        }
+#endif
+
+        for (; i < length; ++i)
+        {
+            if (data1[i] != data2[i])
+                return static_cast<unsigned char>(data1[i]) - static_cast<unsigned char>(data2[i]);
+        }
+
+        return (str1.size() > str2.size()) - (str1.size() < str2.size());
+    }
+
+    // two passes (strlen + compare) - pays off only when lengths are already known,
+    // otherwise the single-pass vectorized std::strcmp from libc is faster (see benchmarks)
+    inline int strcmp(const char* cstr1, const char* cstr2)
+    {
+        return compare(cstr1, cstr2);
+    }
+} // namespace Simd
+
 const char* max_value(const char* cstr1, const char* cstr2);
 
 const char* max_value(const char* cstr1, const char* cstr2)
@@ -90,6 +165,51 @@ TEST_CASE("template function specialization")
     REQUIRE(max_value<const char*>(txt1, txt2) == "Alaska"s);
 }
 
+TEST_CASE("Simd::strcmp")
+{
+    const std::string long_text(200, 'a');
+    const std::vector<std::pair<std::string, std::string>> samples = {
+        {"", ""}, {"Ala", "Alaska"}, {"Alaska", "Ala"}, {"abc", "abd"},
+        {long_text, long_text}, {long_text + "b", long_text + "a"}, {long_text, long_text + "a"}, {long_text.substr(0, 70) + "b" + long_text, long_text},
+        {"\xff", "a"}, {long_text + "\x80", long_text + "\x7f"}};
+
+    auto sign = [](int value) { return (value > 0) - (value < 0); };
+
+    for (const auto& [str1, str2] : samples)
+    {
+        CHECK(sign(Simd::strcmp(str1.c_str(), str2.c_str())) == sign(std::strcmp(str1.c_str(), str2.c_str())));
+        CHECK(sign(Simd::compare(str1, str2)) == sign(str1.compare(str2)));
+    }
+
+    CHECK(max_value("Ala", "Alaska") == "Alaska"s);
+}
+
+TEST_CASE("Simd::strcmp - benchmarks", "[.][benchmark]")
+{
+    const std::string text1 = std::string(4096, 'x') + "a";
+    const std::string text2 = std::string(4096, 'x') + "b";
+
+    BENCHMARK("std::strcmp")
+    {
+        return std::strcmp(text1.c_str(), text2.c_str());
+    };
+
+    BENCHMARK("Simd::strcmp")
+    {
+        return Simd::strcmp(text1.c_str(), text2.c_str());
+    };
+
+    BENCHMARK("Simd::compare - known lengths")
+    {
+        return Simd::compare(text1, text2);
+    };
+
+    BENCHMARK("max_value(const char*, const char*)")
+    {
+        return max_value(text1.c_str(), text2.c_str());
+    };
+}
+
 template <typename T, typename U>
 bool is_greater(const T& val1, const U& val2)
 {
@@ -203,6 +323,246 @@ TEST_CASE("Choosing return types")
     }
 }
 
+namespace AllocationCounter
+{
+    inline std::atomic<size_t> allocations{};
+} // namespace AllocationCounter
+
+void* operator new(size_t size)
+{
+    ++AllocationCounter::allocations;
+    if (void* ptr = std::malloc(size))
+        return ptr;
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+namespace ReturnTypes
+{
+    namespace StringView
+    {
+        // string-like argument that may be viewed after the call: lvalues, pointers & borrowed ranges (std::string_view)
+        template <typename T>
+        concept BorrowedString = std::convertible_to<T, std::string_view>
+            && (std::is_lvalue_reference_v<T> || std::is_pointer_v<std::decay_t<T>> || std::ranges::borrowed_range<T>);
+
+        // returns a view into the winning argument - no std::string temporaries
+        template <BorrowedString T1, BorrowedString T2>
+        std::string_view max_value(T1&& str1, T2&& str2)
+        {
+            const std::string_view sv1 = str1;
+            const std::string_view sv2 = str2;
+
+            return Simd::compare(sv1, sv2) < 0 ? sv2 : sv1;
+        }
+
+        // heterogeneous lookup in ordered containers - find(const char*) or find(std::string_view) do not allocate
+        struct Less
+        {
+            using is_transparent = void;
+
+            bool operator()(std::string_view str1, std::string_view str2) const noexcept
+            {
+                return Simd::compare(str1, str2) < 0;
+            }
+        };
+
+        namespace Words
+        {
+            inline std::uint64_t load(const char* ptr)
+            {
+                std::uint64_t word;
+                std::memcpy(&word, ptr, sizeof(word));
+                return word;
+            }
+
+            // index of the first differing byte in two words loaded from memory
+            inline size_t first_mismatch(std::uint64_t word1, std::uint64_t word2)
+            {
+                const std::uint64_t diff = word1 ^ word2;
+                if constexpr (std::endian::native == std::endian::little)
+                    return std::countr_zero(diff) / 8;
+                else
+                    return std::countl_zero(diff) / 8;
+            }
+
+            // lexicographic comparison - 8 bytes per step
+            inline int compare(std::string_view str1, std::string_view str2)
+            {
+                const size_t length = std::min(str1.size(), str2.size());
+                size_t i = 0;
+
+                for (; i + 8 <= length; i += 8)
+                {
+                    const std::uint64_t word1 = load(str1.data() + i);
+                    const std::uint64_t word2 = load(str2.data() + i);
+                    if (word1 != word2)
+                    {
+                        i += first_mismatch(word1, word2);
+                        break;
+                    }
+                }
+
+                for (; i < length; ++i)
+                {
+                    if (str1[i] != str2[i])
+                        return static_cast<unsigned char>(str1[i]) - static_cast<unsigned char>(str2[i]);
+                }
+
+                return (str1.size() > str2.size()) - (str1.size() < str2.size());
+            }
+        } // namespace Words
+
+        // max of N strings in a single pass - each candidate is compared word by word with the current winner
+        template <std::ranges::forward_range TRange>
+            requires BorrowedString<std::ranges::range_reference_t<const TRange&>>
+        std::string_view max_value(const TRange& strings)
+        {
+            assert(!std::ranges::empty(strings));
+
+            auto it = std::ranges::begin(strings);
+            const auto last = std::ranges::end(strings);
+
+            std::string_view result = *it;
+            for (++it; it != last; ++it)
+            {
+                const std::string_view candidate = *it;
+                if (Words::compare(result, candidate) < 0)
+                    result = candidate;
+            }
+
+            return result;
+        }
+    } // namespace StringView
+} // namespace ReturnTypes
+
+TEST_CASE("max_value for strings without allocations")
+{
+    using ReturnTypes::StringView::max_value;
+
+    const std::string txt1 = "Ala ma kota, a kot ma Ale - text longer than SSO buffer";
+    const char* txt2 = "Ala ma kota, a kot ma Alicje - text longer than SSO buffer";
+
+    SECTION("Trait version allocates std::string for common_type")
+    {
+        const size_t allocations_before = AllocationCounter::allocations;
+        auto result = ReturnTypes::Trait::max_value(txt1, txt2);
+        CHECK(AllocationCounter::allocations > allocations_before);
+        CHECK(result == txt2);
+    }
+
+    SECTION("string_view version returns view into the winning argument")
+    {
+        const size_t allocations_before = AllocationCounter::allocations;
+        std::string_view result = max_value(txt1, txt2);
+        CHECK(AllocationCounter::allocations == allocations_before);
+        CHECK(result.data() == txt2);
+
+        CHECK(max_value("Ala"sv, txt1).data() == txt1.data());
+        CHECK(max_value("Alaska", "Ala") == "Alaska");
+
+        static_assert(!std::invocable<decltype([](auto&& a, auto&& b) -> decltype(max_value(a, std::move(b))) {}), std::string, std::string>,
+            "temporary std::string cannot be returned as a view");
+    }
+
+    SECTION("max of N strings")
+    {
+        const std::vector<std::string> urls = {
+            "https://infotraining.pl/szkolenia/cpp-templates",
+            "https://infotraining.pl/szkolenia/cpp-advanced",
+            "https://infotraining.pl/szkolenia/cpp-templates-2",
+            "https://infotraining.pl/szkolenia/cpp-concurrency"};
+
+        const size_t allocations_before = AllocationCounter::allocations;
+        std::string_view result = max_value(urls);
+        CHECK(AllocationCounter::allocations == allocations_before);
+        CHECK(result.data() == urls[2].data());
+
+        std::vector<const char*> words = {"one", "two", "three", "four", "twenty"};
+        CHECK(max_value(words) == "two");
+
+        std::vector<std::string> single = {"one"};
+        CHECK(max_value(single) == "one");
+
+        std::vector<std::string> with_prefix_of_others = {"abc", "abcdefghijkl", "abcdefghijk", ""};
+        CHECK(max_value(with_prefix_of_others) == "abcdefghijkl");
+    }
+
+    SECTION("heterogeneous lookup")
+    {
+        std::set<std::string, ReturnTypes::StringView::Less> dictionary = {txt1, txt2};
+
+        const size_t allocations_before = AllocationCounter::allocations;
+        CHECK(dictionary.contains(txt2));
+        CHECK(dictionary.contains("Ala"sv) == false);
+        CHECK(AllocationCounter::allocations == allocations_before);
+    }
+}
+
+TEST_CASE("max_value for strings without allocations - benchmarks", "[.][benchmark]")
+{
+    constexpr size_t N = 1'000;
+    const std::string prefix = "https://infotraining.pl/szkolenia/";
+
+    std::vector<std::string> keys;
+    std::mt19937 gen{665};
+    for (size_t i = 0; i < N; ++i)
+        keys.push_back(prefix + std::to_string(gen()));
+
+    auto allocations_per_call = [](auto f) {
+        const size_t allocations_before = AllocationCounter::allocations;
+        f();
+        return AllocationCounter::allocations - allocations_before;
+    };
+
+    std::cout << "allocations per max of " << N << " strings:"
+              << "\n  ReturnTypes::Trait::max_value: " << allocations_per_call([&] {
+                     std::string result = keys[0];
+                     for (const auto& key : keys)
+                         result = ReturnTypes::Trait::max_value(result, key.c_str());
+                     return result;
+                 })
+              << "\n  ReturnTypes::StringView::max_value: " << allocations_per_call([&] {
+                     return ReturnTypes::StringView::max_value(keys);
+                 })
+              << "\n";
+
+    BENCHMARK("ReturnTypes::Trait::max_value - " + std::to_string(N - 1) + " compares")
+    {
+        std::string result = keys[0];
+        for (const auto& key : keys)
+            result = ReturnTypes::Trait::max_value(result, key.c_str());
+        return result;
+    };
+
+    BENCHMARK("ReturnTypes::StringView::max_value(str1, str2) - " + std::to_string(N - 1) + " compares")
+    {
+        std::string_view result = keys[0];
+        for (const auto& key : keys)
+            result = ReturnTypes::StringView::max_value(result, key);
+        return result;
+    };
+
+    BENCHMARK("ReturnTypes::StringView::max_value(range) - " + std::to_string(N - 1) + " compares")
+    {
+        return ReturnTypes::StringView::max_value(keys);
+    };
+
+    BENCHMARK("std::ranges::max - " + std::to_string(N - 1) + " compares")
+    {
+        return std::string_view{std::ranges::max(keys)};
+    };
+}
+
 ///////////////////////////////////
 // C++20 - auto + templates
 auto multiply(auto a, auto b)
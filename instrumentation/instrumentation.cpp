@@ -0,0 +1,224 @@
+#include "instrumentation.hpp"
+
+#include <algorithm>
+#include <catch2/catch_test_case_info.hpp>
+#include <catch2/reporters/catch_reporter_event_listener.hpp>
+#include <catch2/reporters/catch_reporter_registrars.hpp>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <malloc.h>
+#endif
+
+//////////////////////////////////////
+// replaced allocation functions - all forms, the defaults of sanitizer runtimes (-DENABLE_ASAN=ON)
+// do not forward to the replaced single-object forms
+
+namespace
+{
+    void* allocate(std::size_t size)
+    {
+        Instrumentation::record(Instrumentation::Event::allocated);
+        Instrumentation::record(Instrumentation::Event::allocated_bytes, size);
+        return std::malloc(size == 0 ? 1 : size);
+    }
+
+    void* allocate(std::size_t size, std::align_val_t alignment)
+    {
+        Instrumentation::record(Instrumentation::Event::allocated);
+        Instrumentation::record(Instrumentation::Event::allocated_bytes, size);
+
+        const auto align = static_cast<std::size_t>(alignment);
+#ifdef _MSC_VER
+        return _aligned_malloc(size == 0 ? 1 : size, align);
+#else
+        // size must be a multiple of alignment - at least one, aligned_alloc(align, 0) may return null
+        return std::aligned_alloc(align, (std::max<std::size_t>(size, 1) + align - 1) / align * align);
+#endif
+    }
+
+    void deallocate(void* ptr) noexcept
+    {
+        if (ptr == nullptr)
+            return;
+
+        Instrumentation::record(Instrumentation::Event::deallocated);
+        std::free(ptr);
+    }
+
+    void deallocate(void* ptr, std::align_val_t) noexcept
+    {
+        if (ptr == nullptr)
+            return;
+
+        Instrumentation::record(Instrumentation::Event::deallocated);
+#ifdef _MSC_VER
+        _aligned_free(ptr);
+#else
+        std::free(ptr);
+#endif
+    }
+} // namespace
+
+void* operator new(std::size_t size)
+{
+    if (void* ptr = allocate(size))
+        return ptr;
+    throw std::bad_alloc{};
+}
+
+void* operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return allocate(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    if (void* ptr = allocate(size, alignment))
+        return ptr;
+    throw std::bad_alloc{};
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return ::operator new(size, alignment);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return allocate(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return allocate(size, alignment);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+    deallocate(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+    deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t alignment) noexcept
+{
+    deallocate(ptr, alignment);
+}
+
+void operator delete[](void* ptr, std::align_val_t alignment) noexcept
+{
+    deallocate(ptr, alignment);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t alignment) noexcept
+{
+    deallocate(ptr, alignment);
+}
+
+void operator delete[](void* ptr, std::size_t, std::align_val_t alignment) noexcept
+{
+    deallocate(ptr, alignment);
+}
+
+void operator delete(void* ptr, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    deallocate(ptr, alignment);
+}
+
+void operator delete[](void* ptr, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    deallocate(ptr, alignment);
+}
+
+//////////////////////////////////////
+// report mode - ALLOCATION_REPORT=1 <test binary> prints per test case totals (all threads) to stderr
+
+namespace Instrumentation
+{
+    class AllocationReport : public Catch::EventListenerBase
+    {
+        struct Row
+        {
+            std::string test_case;
+            Counts counts;
+        };
+
+        bool enabled = std::getenv("ALLOCATION_REPORT") != nullptr;
+        std::string test_case;
+        Counts start;
+        std::vector<Row> rows;
+
+    public:
+        using Catch::EventListenerBase::EventListenerBase;
+
+        void testCaseStarting(const Catch::TestCaseInfo& info) override
+        {
+            test_case = info.name;
+            start = all_threads();
+        }
+
+        void testCaseEnded(const Catch::TestCaseStats&) override
+        {
+            if (enabled)
+                rows.push_back({test_case, all_threads() - start});
+        }
+
+        void testRunEnded(const Catch::TestRunStats&) override
+        {
+            if (!enabled)
+                return;
+
+            std::clog << "\n"
+                      << std::right << std::setw(12) << "allocations" << std::setw(14) << "bytes" << std::setw(10) << "copies"
+                      << std::setw(10) << "moves" << "  test case\n"
+                      << std::string(98, '-') << "\n";
+
+            for (const auto& [name, counts] : rows)
+            {
+                std::clog << std::setw(12) << counts.allocations() << std::setw(14) << counts.allocated_bytes() << std::setw(10)
+                          << counts.copies() << std::setw(10) << counts.moves() << "  " << name << "\n";
+            }
+        }
+    };
+
+    CATCH_REGISTER_LISTENER(AllocationReport)
+} // namespace Instrumentation
@@ -0,0 +1,202 @@
+#ifndef INSTRUMENTATION_HPP
+#define INSTRUMENTATION_HPP
+
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+// Counters of constructions, copies, moves & destructions of Probe<T> objects and of heap
+// allocations (replaced operator new - instrumentation.cpp). Every event is counted for
+// the thread that caused it and for the whole process.
+//
+//   Instrumentation::Scope scope;
+//   use(Probe<Gadget>{1, "ipad"});
+//   REQUIRE(scope.counts().copies() == 0);
+
+namespace Instrumentation
+{
+    enum class Event : size_t
+    {
+        default_constructed,
+        constructed,
+        copy_constructed,
+        move_constructed,
+        copy_assigned,
+        move_assigned,
+        destroyed,
+        allocated,
+        deallocated,
+        allocated_bytes
+    };
+
+    inline constexpr size_t event_count = static_cast<size_t>(Event::allocated_bytes) + 1;
+
+    struct Counts
+    {
+        std::array<size_t, event_count> values{};
+
+        constexpr size_t operator[](Event event) const
+        {
+            return values[static_cast<size_t>(event)];
+        }
+
+        constexpr size_t constructions() const
+        {
+            return (*this)[Event::default_constructed] + (*this)[Event::constructed] + copies_constructed() + moves_constructed();
+        }
+
+        constexpr size_t copies() const
+        {
+            return copies_constructed() + (*this)[Event::copy_assigned];
+        }
+
+        constexpr size_t moves() const
+        {
+            return moves_constructed() + (*this)[Event::move_assigned];
+        }
+
+        constexpr size_t destructions() const
+        {
+            return (*this)[Event::destroyed];
+        }
+
+        constexpr size_t allocations() const
+        {
+            return (*this)[Event::allocated];
+        }
+
+        constexpr size_t deallocations() const
+        {
+            return (*this)[Event::deallocated];
+        }
+
+        constexpr size_t allocated_bytes() const
+        {
+            return (*this)[Event::allocated_bytes];
+        }
+
+        constexpr bool operator==(const Counts&) const = default;
+
+        friend constexpr Counts operator-(Counts lhs, const Counts& rhs)
+        {
+            for (size_t i = 0; i < event_count; ++i)
+                lhs.values[i] -= rhs.values[i];
+            return lhs;
+        }
+
+    private:
+        constexpr size_t copies_constructed() const
+        {
+            return (*this)[Event::copy_constructed];
+        }
+
+        constexpr size_t moves_constructed() const
+        {
+            return (*this)[Event::move_constructed];
+        }
+    };
+
+    namespace Details
+    {
+        // no dynamic initialization - safe to use from operator new of any thread at any time
+        inline constinit thread_local Counts thread_counts{};
+        inline constinit std::array<std::atomic<size_t>, event_count> process_counts{};
+    } // namespace Details
+
+    inline void record(Event event, size_t n = 1) noexcept
+    {
+        const auto index = static_cast<size_t>(event);
+        Details::thread_counts.values[index] += n;
+        Details::process_counts[index].fetch_add(n, std::memory_order_relaxed);
+    }
+
+    inline Counts this_thread() noexcept
+    {
+        return Details::thread_counts;
+    }
+
+    inline Counts all_threads() noexcept
+    {
+        Counts counts;
+        for (size_t i = 0; i < event_count; ++i)
+            counts.values[i] = Details::process_counts[i].load(std::memory_order_relaxed);
+        return counts;
+    }
+
+    // events of the current thread since construction
+    class Scope
+    {
+        Counts start = this_thread();
+
+    public:
+        Counts counts() const noexcept
+        {
+            return this_thread() - start;
+        }
+    };
+
+    //////////////////////////////////////
+    // Probe<T> - T with counted special member functions
+
+    template <typename T>
+        requires std::is_class_v<T>
+    class Probe : public T
+    {
+    public:
+        Probe() noexcept(std::is_nothrow_default_constructible_v<T>)
+            requires std::default_initializable<T>
+            : T{}
+        {
+            record(Event::default_constructed);
+        }
+
+        template <typename... TArgs>
+            requires(sizeof...(TArgs) > 0)
+            && (sizeof...(TArgs) > 1 || (!std::same_as<std::remove_cvref_t<TArgs>, Probe> && ...))
+            && std::constructible_from<T, TArgs...>
+        explicit(sizeof...(TArgs) == 1 && !(std::is_convertible_v<TArgs, T> && ...))
+            Probe(TArgs&&... args)
+            : T(std::forward<TArgs>(args)...)
+        {
+            record(Event::constructed);
+        }
+
+        Probe(const Probe& other)
+            : T(static_cast<const T&>(other))
+        {
+            record(Event::copy_constructed);
+        }
+
+        Probe(Probe&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+            : T(static_cast<T&&>(other))
+        {
+            record(Event::move_constructed);
+        }
+
+        Probe& operator=(const Probe& other)
+        {
+            T::operator=(static_cast<const T&>(other));
+            record(Event::copy_assigned);
+            return *this;
+        }
+
+        Probe& operator=(Probe&& other) noexcept(std::is_nothrow_move_assignable_v<T>)
+        {
+            T::operator=(static_cast<T&&>(other));
+            record(Event::move_assigned);
+            return *this;
+        }
+
+        ~Probe()
+        {
+            record(Event::destroyed);
+        }
+    };
+} // namespace Instrumentation
+
+using Instrumentation::Probe;
+
+#endif
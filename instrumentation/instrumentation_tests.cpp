@@ -0,0 +1,335 @@
+#include "timing.hpp"
+
+#include <algorithm>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+using namespace Instrumentation;
+
+#ifdef TIMING_HAS_TSC
+// declared first - in the default order this timer starts before TscClock is calibrated
+TEST_CASE("TscClock - a Tracing timer is the first use of the clock")
+{
+    const auto steady_now_ns = [] {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+    };
+
+    const uint64_t before = steady_now_ns();
+    {
+        Timing::ScopedTimer<Timing::Tracing<Timing::TscClock>, "test::tsc_first_use"> timer;
+    }
+    const uint64_t after = steady_now_ns();
+
+    const auto events = Timing::trace_point<"test::tsc_first_use">.events();
+    REQUIRE(events.size() == 1);
+    REQUIRE(events[0].second.size() == 1);
+
+    // the start precedes the calibration epoch - still a time stamp between before & after (with some slack)
+    const uint64_t start_ns = events[0].second[0].start_ns;
+    REQUIRE(start_ns + 1'000'000 >= before);
+    REQUIRE(start_ns <= after + 1'000'000);
+
+    const auto& calibration = Timing::TscClock::calibration();
+    REQUIRE(Timing::TscClock::timestamp_ns(calibration.tsc_epoch - 1'000'000) < calibration.steady_epoch_ns);
+}
+#endif
+
+TEST_CASE("latency histogram - buckets")
+{
+    SECTION("small values have exact buckets")
+    {
+        for (uint64_t value = 0; value < 2 * Timing::sub_bucket_count; ++value)
+        {
+            REQUIRE(Timing::bucket_lower_bound(Timing::bucket_index(value)) == value);
+            REQUIRE(Timing::bucket_upper_bound(Timing::bucket_index(value)) == value);
+        }
+    }
+
+    SECTION("every value lies within its bucket - relative error below 1/16")
+    {
+        for (uint64_t value = 1; value < (uint64_t{1} << 62); value = value * 3 + 7)
+        {
+            const size_t index = Timing::bucket_index(value);
+            const uint64_t lower = Timing::bucket_lower_bound(index);
+            const uint64_t upper = Timing::bucket_upper_bound(index);
+
+            REQUIRE(lower <= value);
+            REQUIRE(value <= upper);
+            REQUIRE((upper - lower) * Timing::sub_bucket_count <= lower);
+        }
+    }
+
+    SECTION("buckets are contiguous")
+    {
+        for (size_t index = 0; index + 1 < Timing::bucket_count; ++index)
+            REQUIRE(Timing::bucket_upper_bound(index) + 1 == Timing::bucket_lower_bound(index + 1));
+    }
+}
+
+TEST_CASE("trace point - snapshot & merge")
+{
+    Timing::TracePoint point{"test::snapshot"};
+
+    for (uint64_t duration = 1; duration <= 1000; ++duration)
+        point.record(duration);
+
+    const Timing::HistogramSnapshot snapshot = point.snapshot();
+
+    REQUIRE(snapshot.count == 1000);
+    REQUIRE(snapshot.sum_ns == 500'500);
+    REQUIRE(snapshot.min_ns == 1);
+    REQUIRE(snapshot.max_ns == 1000);
+    REQUIRE(snapshot.mean_ns() == 500.5);
+
+    const uint64_t median = snapshot.percentile_ns(50);
+    REQUIRE(median >= 500);
+    REQUIRE(median <= 500 + 500 / Timing::sub_bucket_count);
+    REQUIRE(snapshot.percentile_ns(100) == 1000);
+    REQUIRE(snapshot.percentile_ns(0) == 1);
+
+    SECTION("merge")
+    {
+        Timing::HistogramSnapshot merged = snapshot;
+        merged.merge(snapshot);
+
+        REQUIRE(merged.count == 2000);
+        REQUIRE(merged.percentile_ns(50) == median);
+    }
+
+    SECTION("registry merges trace points with the same name")
+    {
+        Timing::TracePoint other{"test::snapshot"};
+        other.record(5000);
+
+        const auto by_name = Timing::snapshot("test::snapshot");
+        REQUIRE(by_name.has_value());
+        REQUIRE(by_name->count == 1001);
+        REQUIRE(by_name->max_ns == 5000);
+    }
+}
+
+TEST_CASE("trace point - per thread histograms")
+{
+    Timing::TracePoint point{"test::threads"};
+    constexpr int thread_count = 4;
+    constexpr int records_per_thread = 10'000;
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < thread_count; ++i)
+        threads.emplace_back([&point] {
+            for (int n = 0; n < records_per_thread; ++n)
+                point.record(n % 100);
+        });
+
+    for (auto& thd : threads)
+        thd.join();
+
+    REQUIRE(point.snapshot().count == thread_count * records_per_thread);
+}
+
+TEST_CASE("scoped timer - policies")
+{
+    SECTION("Disabled is an empty class - no trace point is instantiated")
+    {
+        static_assert(std::is_empty_v<Timing::ScopedTimer<Timing::Disabled, "test::disabled">>);
+
+        {
+            Timing::ScopedTimer<Timing::Disabled, "test::disabled"> timer;
+        }
+
+        REQUIRE_FALSE(Timing::snapshot("test::disabled").has_value());
+    }
+
+    SECTION("Histograms records durations")
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            Timing::ScopedTimer<Timing::Histograms<>, "test::histograms"> timer;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        const auto snapshot = Timing::snapshot("test::histograms");
+        REQUIRE(snapshot->count == 3);
+        REQUIRE(snapshot->min_ns >= 1'000'000);
+        REQUIRE(snapshot->max_ns < 1'000'000'000);
+        REQUIRE(Timing::trace_point<"test::histograms">.events().empty());
+    }
+
+    SECTION("SteadyClock")
+    {
+        {
+            Timing::ScopedTimer<Timing::Histograms<Timing::SteadyClock>, "test::steady"> timer;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        REQUIRE(Timing::snapshot("test::steady")->min_ns >= 1'000'000);
+    }
+
+    SECTION("SteadyClock timestamps - nanoseconds since the steady_clock epoch")
+    {
+        const auto before = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        const uint64_t timestamp = Timing::SteadyClock::timestamp_ns(Timing::SteadyClock::now());
+        const auto after = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+
+        REQUIRE(timestamp >= static_cast<uint64_t>(before));
+        REQUIRE(timestamp <= static_cast<uint64_t>(after));
+
+        // beyond the ~18 s where ticks * 1e9 overflowed
+        const uint64_t hours = 2 * 3600;
+        const auto ticks = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::seconds(hours)).count();
+        REQUIRE(Timing::SteadyClock::timestamp_ns(static_cast<uint64_t>(ticks)) == hours * 1'000'000'000);
+    }
+
+    SECTION("Tracing records events for the Chrome trace")
+    {
+        {
+            Timing::ScopedTimer<Timing::Tracing<>, "test::tracing"> timer;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        const auto events = Timing::trace_point<"test::tracing">.events();
+        REQUIRE(events.size() == 1);
+        REQUIRE(events[0].second.size() == 1);
+        REQUIRE(events[0].second[0].duration_ns >= 1'000'000);
+
+        std::ostringstream trace;
+        Timing::write_chrome_trace(trace);
+
+        REQUIRE(trace.str().starts_with("{\"traceEvents\": ["));
+        REQUIRE(trace.str().find("\"name\": \"test::tracing\", \"cat\": \"timing\", \"ph\": \"X\"") != std::string::npos);
+    }
+}
+
+namespace
+{
+    template <typename TPolicy>
+    int timed_accumulate(const std::vector<int>& data)
+    {
+        Timing::ScopedTimer<TPolicy, "accumulate"> timer;
+        return std::accumulate(data.begin(), data.end(), 0);
+    }
+
+    // a clock without the cost of reading the time - the timer's own bookkeeping
+    struct CountingClock
+    {
+        static inline uint64_t ticks = 0;
+
+        static uint64_t now() noexcept
+        {
+            return ++ticks;
+        }
+
+        static uint64_t elapsed_ns(uint64_t start, uint64_t end) noexcept
+        {
+            return end - start;
+        }
+
+        static uint64_t timestamp_ns(uint64_t ticks) noexcept
+        {
+            return ticks;
+        }
+    };
+
+    // the fastest of a few rounds - noise only adds time
+    template <typename F>
+    double ns_per_call(F f)
+    {
+        constexpr int calls = 100'000;
+
+        [[maybe_unused]] volatile int sink = 0;
+        double best = std::numeric_limits<double>::max();
+        for (int round = 0; round < 5; ++round)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < calls; ++i)
+                sink = f();
+            const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+            best = std::min(best, elapsed.count() / calls);
+        }
+
+        return best;
+    }
+} // namespace
+
+TEST_CASE("replaced operator new - zero-size aligned allocation")
+{
+    constexpr std::align_val_t alignment{64};
+
+    void* ptr = ::operator new(0, alignment); // throws std::bad_alloc if the allocator returns null for size 0
+    REQUIRE(ptr != nullptr);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(ptr) % 64 == 0);
+    ::operator delete(ptr, alignment);
+}
+
+TEST_CASE("scoped timer - benchmarks", "[.][benchmark]")
+{
+    const std::vector<int> data(16, 42);
+
+    BENCHMARK("accumulate - no timer")
+    {
+        return std::accumulate(data.begin(), data.end(), 0);
+    };
+
+    BENCHMARK("accumulate - ScopedTimer<Disabled>")
+    {
+        return timed_accumulate<Timing::Disabled>(data);
+    };
+
+    BENCHMARK("accumulate - ScopedTimer<Histograms<>>")
+    {
+        return timed_accumulate<Timing::Histograms<>>(data);
+    };
+
+    BENCHMARK("accumulate - ScopedTimer<Histograms<SteadyClock>>")
+    {
+        return timed_accumulate<Timing::Histograms<Timing::SteadyClock>>(data);
+    };
+
+    BENCHMARK("accumulate - ScopedTimer<Tracing<>>")
+    {
+        return timed_accumulate<Timing::Tracing<>>(data);
+    };
+
+    // the timer's cost without the two clock reads
+    Timing::TracePoint& point = Timing::trace_point<"accumulate">;
+    uint64_t duration = 0;
+
+    BENCHMARK("TracePoint::record(duration)")
+    {
+        point.record(++duration % 4096);
+        return duration;
+    };
+
+    BENCHMARK("DefaultClock::now()")
+    {
+        return Timing::DefaultClock::now();
+    };
+
+    const auto snapshot = Timing::snapshot("accumulate");
+    REQUIRE(snapshot.has_value());
+
+    // the requirements - Disabled adds nothing, an enabled timer costs under 20 ns besides its two clock reads
+    // (CountingClock) - rdtsc takes ~10 ns on bare metal, but may trap (~40 ns measured) in a VM
+    const double plain_ns = ns_per_call([&] { return std::accumulate(data.begin(), data.end(), 0); });
+    const double disabled_ns = ns_per_call([&] { return timed_accumulate<Timing::Disabled>(data); });
+    const double bookkeeping_ns = ns_per_call([&] { return timed_accumulate<Timing::Histograms<CountingClock>>(data); });
+    const double enabled_ns = ns_per_call([&] { return timed_accumulate<Timing::Histograms<>>(data); });
+
+    INFO("no timer: " << plain_ns << " ns, Disabled: " << disabled_ns << " ns, Histograms<CountingClock>: " << bookkeeping_ns
+                      << " ns, Histograms<>: " << enabled_ns << " ns");
+    CHECK(disabled_ns - plain_ns < 1.0);
+    CHECK(bookkeeping_ns - plain_ns < 20.0);
+
+    if (enabled_ns - plain_ns >= 20.0)
+        WARN("ScopedTimer<Histograms<>> costs " << enabled_ns - plain_ns << " ns including the clock reads");
+}
@@ -0,0 +1,263 @@
+#include "timing.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <ostream>
+
+namespace Instrumentation::Timing
+{
+    namespace
+    {
+        class Registry
+        {
+            std::mutex mutex;
+            std::vector<const TracePoint*> points;
+
+        public:
+            static Registry& instance()
+            {
+                static Registry registry;
+                return registry;
+            }
+
+            void add(const TracePoint* point)
+            {
+                std::lock_guard lock{mutex};
+                points.push_back(point);
+            }
+
+            void remove(const TracePoint* point)
+            {
+                std::lock_guard lock{mutex};
+                std::erase(points, point);
+            }
+
+            template <typename TFunction>
+            void for_each(TFunction function)
+            {
+                std::lock_guard lock{mutex};
+                for (const TracePoint* point : points)
+                    function(*point);
+            }
+        };
+
+        std::string json_escaped(std::string_view text)
+        {
+            std::string result;
+            for (char c : text)
+            {
+                if (c == '"' || c == '\\')
+                    result += '\\';
+                result += c;
+            }
+            return result;
+        }
+
+        // Chrome trace timestamps & durations are microseconds
+        void write_microseconds(std::ostream& out, uint64_t ns)
+        {
+            out << ns / 1000 << '.' << std::setfill('0') << std::setw(3) << ns % 1000 << std::setfill(' ');
+        }
+    } // namespace
+
+    size_t Details::assign_thread_index() noexcept
+    {
+        static std::atomic<size_t> thread_count{0};
+        return thread_count.fetch_add(1, std::memory_order_relaxed) % max_threads;
+    }
+
+    //////////////////////////////////////
+    // HistogramSnapshot
+
+    HistogramSnapshot& HistogramSnapshot::merge(const HistogramSnapshot& other) noexcept
+    {
+        for (size_t i = 0; i < bucket_count; ++i)
+            buckets[i] += other.buckets[i];
+
+        count += other.count;
+        sum_ns += other.sum_ns;
+        min_ns = std::min(min_ns, other.min_ns);
+        max_ns = std::max(max_ns, other.max_ns);
+        return *this;
+    }
+
+    double HistogramSnapshot::mean_ns() const noexcept
+    {
+        return count == 0 ? 0.0 : double(sum_ns) / double(count);
+    }
+
+    uint64_t HistogramSnapshot::percentile_ns(double percentile) const noexcept
+    {
+        if (count == 0)
+            return 0;
+
+        const auto rank = static_cast<uint64_t>(std::clamp(percentile, 0.0, 100.0) / 100.0 * double(count - 1)) + 1;
+
+        uint64_t seen = 0;
+        for (size_t i = 0; i < bucket_count; ++i)
+        {
+            seen += buckets[i];
+            if (seen >= rank)
+                return std::clamp(bucket_upper_bound(i), min_ns, max_ns);
+        }
+        return max_ns;
+    }
+
+    void LatencyHistogram::snapshot_into(HistogramSnapshot& snapshot) const noexcept
+    {
+        HistogramSnapshot own;
+        for (size_t i = 0; i < bucket_count; ++i)
+            own.buckets[i] = buckets[i].load(std::memory_order_relaxed);
+
+        own.count = count.load(std::memory_order_relaxed);
+        own.sum_ns = sum_ns.load(std::memory_order_relaxed);
+        own.min_ns = min_ns.load(std::memory_order_relaxed);
+        own.max_ns = max_ns.load(std::memory_order_relaxed);
+
+        snapshot.merge(own);
+    }
+
+    std::vector<TraceEvent> EventRing::events() const
+    {
+        const uint64_t end = written.load(std::memory_order_acquire);
+        const uint64_t begin = end > capacity ? end - capacity : 0;
+
+        std::vector<TraceEvent> result;
+        result.reserve(end - begin);
+        for (uint64_t i = begin; i < end; ++i)
+        {
+            const Slot& slot = slots[i % capacity];
+            result.push_back({slot.start_ns.load(std::memory_order_relaxed), slot.duration_ns.load(std::memory_order_relaxed)});
+        }
+        return result;
+    }
+
+    //////////////////////////////////////
+    // TracePoint
+
+    TracePoint::TracePoint(std::string_view name)
+        : label{name}
+    {
+        Registry::instance().add(this);
+    }
+
+    TracePoint::~TracePoint()
+    {
+        Registry::instance().remove(this);
+
+        for (auto& slot : threads)
+        {
+            if (PerThread* per_thread = slot.load(std::memory_order_acquire))
+            {
+                delete per_thread->events.load(std::memory_order_acquire);
+                delete per_thread;
+            }
+        }
+    }
+
+    TracePoint::PerThread& TracePoint::create(size_t index)
+    {
+        // another thread may share the slot index (more than max_threads threads)
+        auto* created = new PerThread;
+        PerThread* expected = nullptr;
+        if (threads[index].compare_exchange_strong(expected, created, std::memory_order_acq_rel))
+            return *created;
+
+        delete created;
+        return *expected;
+    }
+
+    EventRing& TracePoint::create_events(PerThread& per_thread)
+    {
+        auto* created = new EventRing;
+        EventRing* expected = nullptr;
+        if (per_thread.events.compare_exchange_strong(expected, created, std::memory_order_acq_rel))
+            return *created;
+
+        delete created;
+        return *expected;
+    }
+
+    HistogramSnapshot TracePoint::snapshot() const
+    {
+        HistogramSnapshot result;
+        for (const auto& slot : threads)
+        {
+            if (const PerThread* per_thread = slot.load(std::memory_order_acquire))
+                per_thread->histogram.snapshot_into(result);
+        }
+        return result;
+    }
+
+    std::vector<std::pair<size_t, std::vector<TraceEvent>>> TracePoint::events() const
+    {
+        std::vector<std::pair<size_t, std::vector<TraceEvent>>> result;
+        for (size_t index = 0; index < max_threads; ++index)
+        {
+            const PerThread* per_thread = threads[index].load(std::memory_order_acquire);
+            if (per_thread == nullptr)
+                continue;
+
+            if (const EventRing* ring = per_thread->events.load(std::memory_order_acquire))
+                result.emplace_back(index, ring->events());
+        }
+        return result;
+    }
+
+    //////////////////////////////////////
+    // snapshots & export
+
+    std::vector<NamedSnapshot> snapshot()
+    {
+        std::map<std::string, HistogramSnapshot, std::less<>> by_name;
+        Registry::instance().for_each([&](const TracePoint& point) {
+            by_name[std::string{point.name()}].merge(point.snapshot());
+        });
+
+        std::vector<NamedSnapshot> result;
+        for (auto& [name, histogram] : by_name)
+            result.push_back({name, histogram});
+        return result;
+    }
+
+    std::optional<HistogramSnapshot> snapshot(std::string_view name)
+    {
+        std::optional<HistogramSnapshot> result;
+        Registry::instance().for_each([&](const TracePoint& point) {
+            if (point.name() != name)
+                return;
+
+            if (!result)
+                result.emplace();
+            result->merge(point.snapshot());
+        });
+        return result;
+    }
+
+    void write_chrome_trace(std::ostream& out)
+    {
+        out << "{\"traceEvents\": [\n";
+
+        bool first = true;
+        Registry::instance().for_each([&](const TracePoint& point) {
+            const std::string name = json_escaped(point.name());
+            for (const auto& [thread, events] : point.events())
+            {
+                for (const auto& [start_ns, duration_ns] : events)
+                {
+                    out << (first ? "  " : ",\n  ") << "{\"name\": \"" << name << "\", \"cat\": \"timing\", \"ph\": \"X\", \"pid\": 1"
+                        << ", \"tid\": " << thread << ", \"ts\": ";
+                    write_microseconds(out, start_ns);
+                    out << ", \"dur\": ";
+                    write_microseconds(out, duration_ns);
+                    out << "}";
+                    first = false;
+                }
+            }
+        });
+
+        out << "\n]}\n";
+    }
+} // namespace Instrumentation::Timing
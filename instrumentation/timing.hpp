@@ -0,0 +1,412 @@
+#ifndef TIMING_HPP
+#define TIMING_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define TIMING_HAS_TSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define TIMING_HAS_TSC 1
+#endif
+
+// Scoped timers feeding per-thread latency histograms of named trace points.
+//
+//   template <typename T, typename TTimingPolicy = Timing::Disabled>
+//   void push(const T& item)
+//   {
+//       Timing::ScopedTimer<TTimingPolicy, "Stack::push"> timer;
+//       ...
+//   }
+//
+// Timing::Disabled compiles the timer out - ScopedTimer is an empty class and the trace point
+// is never instantiated. Timing::Histograms<TClock> records durations only, Timing::Tracing<TClock>
+// also keeps the recent events of every thread for the Chrome trace exporter.
+
+namespace Instrumentation::Timing
+{
+    //////////////////////////////////////
+    // clocks - now() in ticks, converted to nanoseconds of the steady_clock timeline
+
+    struct SteadyClock
+    {
+        static uint64_t now() noexcept
+        {
+            return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+        }
+
+        static uint64_t elapsed_ns(uint64_t start, uint64_t end) noexcept
+        {
+            return timestamp_ns(end - start);
+        }
+
+        // duration_cast - ticks * num * 1e9 would overflow uint64_t after ~18 s for a nanosecond period
+        static uint64_t timestamp_ns(uint64_t ticks) noexcept
+        {
+            const std::chrono::steady_clock::duration duration{static_cast<std::chrono::steady_clock::rep>(ticks)};
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+        }
+    };
+
+#ifdef TIMING_HAS_TSC
+    // time stamp counter - assumes an invariant TSC (constant rate, synchronized between cores)
+    struct TscClock
+    {
+        struct Calibration
+        {
+            double ns_per_tick;
+            uint64_t tsc_epoch;
+            uint64_t steady_epoch_ns;
+        };
+
+        static const Calibration& calibration() noexcept
+        {
+            static const Calibration calibrated = [] {
+                const uint64_t steady_start = SteadyClock::timestamp_ns(SteadyClock::now());
+                const uint64_t tsc_start = now();
+
+                uint64_t steady_end = steady_start;
+                while (steady_end - steady_start < 2'000'000)
+                    steady_end = SteadyClock::timestamp_ns(SteadyClock::now());
+
+                const uint64_t tsc_end = now();
+                return Calibration{double(steady_end - steady_start) / double(tsc_end - tsc_start), tsc_start, steady_start};
+            }();
+
+            return calibrated;
+        }
+
+        static uint64_t now() noexcept
+        {
+            return __rdtsc();
+        }
+
+        static uint64_t elapsed_ns(uint64_t start, uint64_t end) noexcept
+        {
+            return static_cast<uint64_t>(double(end - start) * calibration().ns_per_tick);
+        }
+
+        // ticks may precede tsc_epoch (a timer started before the lazy calibration) - a negative offset
+        // is converted in int64_t & added with unsigned wraparound
+        static uint64_t timestamp_ns(uint64_t ticks) noexcept
+        {
+            const Calibration& c = calibration();
+            const int64_t offset_ns = static_cast<int64_t>(double(static_cast<int64_t>(ticks - c.tsc_epoch)) * c.ns_per_tick);
+            return c.steady_epoch_ns + static_cast<uint64_t>(offset_ns);
+        }
+    };
+
+    using DefaultClock = TscClock;
+#else
+    using DefaultClock = SteadyClock;
+#endif
+
+    //////////////////////////////////////
+    // policies
+
+    struct Disabled
+    {
+        static constexpr bool enabled = false;
+    };
+
+    template <typename TClock = DefaultClock>
+    struct Histograms
+    {
+        static constexpr bool enabled = true;
+        static constexpr bool trace_events = false;
+        using Clock = TClock;
+    };
+
+    template <typename TClock = DefaultClock>
+    struct Tracing
+    {
+        static constexpr bool enabled = true;
+        static constexpr bool trace_events = true;
+        using Clock = TClock;
+    };
+
+    //////////////////////////////////////
+    // HDR-style histogram - 16 linear sub-buckets per power of two, relative error below 1/16
+
+    inline constexpr unsigned sub_bucket_bits = 4;
+    inline constexpr size_t sub_bucket_count = size_t{1} << sub_bucket_bits;
+    inline constexpr size_t bucket_count = (64 - sub_bucket_bits + 1) * sub_bucket_count;
+
+    constexpr size_t bucket_index(uint64_t value) noexcept
+    {
+        const unsigned shift = std::max(static_cast<unsigned>(std::bit_width(value)), sub_bucket_bits + 1) - (sub_bucket_bits + 1);
+        return shift * sub_bucket_count + static_cast<size_t>(value >> shift);
+    }
+
+    constexpr uint64_t bucket_lower_bound(size_t index) noexcept
+    {
+        if (index < 2 * sub_bucket_count)
+            return index;
+
+        const size_t shift = index / sub_bucket_count - 1;
+        return static_cast<uint64_t>(index - shift * sub_bucket_count) << shift;
+    }
+
+    constexpr uint64_t bucket_upper_bound(size_t index) noexcept
+    {
+        return index + 1 < bucket_count ? bucket_lower_bound(index + 1) - 1 : std::numeric_limits<uint64_t>::max();
+    }
+
+    static_assert(bucket_index(15) == 15 && bucket_index(31) == 31 && bucket_index(32) == 32);
+    static_assert(bucket_lower_bound(bucket_index(1'000'003)) <= 1'000'003 && 1'000'003 <= bucket_upper_bound(bucket_index(1'000'003)));
+    static_assert(bucket_index(std::numeric_limits<uint64_t>::max()) == bucket_count - 1);
+
+    struct HistogramSnapshot
+    {
+        std::array<uint64_t, bucket_count> buckets{};
+        uint64_t count = 0;
+        uint64_t sum_ns = 0;
+        uint64_t min_ns = std::numeric_limits<uint64_t>::max();
+        uint64_t max_ns = 0;
+
+        HistogramSnapshot& merge(const HistogramSnapshot& other) noexcept;
+
+        double mean_ns() const noexcept;
+
+        // upper bound of the bucket holding the given percentile (0 - 100), clamped to max_ns
+        uint64_t percentile_ns(double percentile) const noexcept;
+    };
+
+    // written by a single thread, read by any - relaxed load & store instead of read-modify-write
+    class LatencyHistogram
+    {
+        std::array<std::atomic<uint64_t>, bucket_count> buckets{};
+        std::atomic<uint64_t> count{0};
+        std::atomic<uint64_t> sum_ns{0};
+        std::atomic<uint64_t> min_ns{std::numeric_limits<uint64_t>::max()};
+        std::atomic<uint64_t> max_ns{0};
+
+        static void add(std::atomic<uint64_t>& counter, uint64_t value) noexcept
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+
+    public:
+        void record(uint64_t duration_ns) noexcept
+        {
+            add(buckets[bucket_index(duration_ns)], 1);
+            add(count, 1);
+            add(sum_ns, duration_ns);
+
+            if (duration_ns < min_ns.load(std::memory_order_relaxed))
+                min_ns.store(duration_ns, std::memory_order_relaxed);
+            if (duration_ns > max_ns.load(std::memory_order_relaxed))
+                max_ns.store(duration_ns, std::memory_order_relaxed);
+        }
+
+        void snapshot_into(HistogramSnapshot& snapshot) const noexcept;
+    };
+
+    //////////////////////////////////////
+    // recent events of a thread - a ring buffer overwriting the oldest entries
+
+    struct TraceEvent
+    {
+        uint64_t start_ns;
+        uint64_t duration_ns;
+    };
+
+    class EventRing
+    {
+    public:
+        static constexpr size_t capacity = 4096;
+
+        void record(uint64_t start_ns, uint64_t duration_ns) noexcept
+        {
+            const uint64_t index = written.load(std::memory_order_relaxed);
+            Slot& slot = slots[index % capacity];
+            slot.start_ns.store(start_ns, std::memory_order_relaxed);
+            slot.duration_ns.store(duration_ns, std::memory_order_relaxed);
+            written.store(index + 1, std::memory_order_release);
+        }
+
+        std::vector<TraceEvent> events() const;
+
+    private:
+        struct Slot
+        {
+            std::atomic<uint64_t> start_ns{0};
+            std::atomic<uint64_t> duration_ns{0};
+        };
+
+        std::array<Slot, capacity> slots{};
+        std::atomic<uint64_t> written{0};
+    };
+
+    //////////////////////////////////////
+    // trace point - a named site with lazily created per-thread histograms
+
+    inline constexpr size_t max_threads = 256;
+
+    namespace Details
+    {
+        inline constinit thread_local size_t thread_slot = max_threads;
+
+        size_t assign_thread_index() noexcept;
+    } // namespace Details
+
+    // threads beyond max_threads share slots (counts may then be lost - never corrupted)
+    inline size_t thread_index() noexcept
+    {
+        const size_t index = Details::thread_slot;
+        if (index == max_threads) [[unlikely]]
+            return Details::thread_slot = Details::assign_thread_index();
+        return index;
+    }
+
+    class TracePoint
+    {
+        struct PerThread
+        {
+            LatencyHistogram histogram;
+            std::atomic<EventRing*> events{nullptr};
+        };
+
+        std::string_view label;
+        std::array<std::atomic<PerThread*>, max_threads> threads{};
+
+        PerThread& create(size_t index);
+        EventRing& create_events(PerThread& per_thread);
+
+        PerThread& this_thread() noexcept
+        {
+            const size_t index = thread_index();
+            PerThread* per_thread = threads[index].load(std::memory_order_acquire);
+            if (per_thread == nullptr) [[unlikely]]
+                return create(index);
+            return *per_thread;
+        }
+
+    public:
+        explicit TracePoint(std::string_view name);
+        TracePoint(const TracePoint&) = delete;
+        TracePoint& operator=(const TracePoint&) = delete;
+        ~TracePoint();
+
+        std::string_view name() const noexcept
+        {
+            return label;
+        }
+
+        void record(uint64_t duration_ns) noexcept
+        {
+            this_thread().histogram.record(duration_ns);
+        }
+
+        void record(uint64_t start_ns, uint64_t duration_ns) noexcept
+        {
+            PerThread& per_thread = this_thread();
+            per_thread.histogram.record(duration_ns);
+
+            EventRing* events = per_thread.events.load(std::memory_order_relaxed);
+            if (events == nullptr) [[unlikely]]
+                events = &create_events(per_thread);
+            events->record(start_ns, duration_ns);
+        }
+
+        // histograms of all threads merged
+        HistogramSnapshot snapshot() const;
+
+        // recent events per thread index
+        std::vector<std::pair<size_t, std::vector<TraceEvent>>> events() const;
+    };
+
+    template <size_t N>
+    struct FixedString
+    {
+        char text[N]{};
+
+        constexpr FixedString(const char (&str)[N])
+        {
+            std::copy_n(str, N, text);
+        }
+
+        constexpr std::string_view view() const
+        {
+            return {text, N - 1};
+        }
+    };
+
+    template <FixedString Name>
+    inline TracePoint trace_point{Name.view()};
+
+    //////////////////////////////////////
+    // scoped timer
+
+    template <typename TPolicy, FixedString Name>
+    class ScopedTimer
+    {
+        using Clock = typename TPolicy::Clock;
+
+        uint64_t start = Clock::now();
+
+    public:
+        ScopedTimer() = default;
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+        ~ScopedTimer()
+        {
+            const uint64_t end = Clock::now();
+            const uint64_t duration_ns = Clock::elapsed_ns(start, end);
+
+            if constexpr (TPolicy::trace_events)
+                trace_point<Name>.record(Clock::timestamp_ns(start), duration_ns);
+            else
+                trace_point<Name>.record(duration_ns);
+        }
+    };
+
+    // user-provided constructor & destructor - a disabled timer is not reported as an unused variable
+    template <typename TPolicy, FixedString Name>
+        requires(!TPolicy::enabled)
+    class ScopedTimer<TPolicy, Name>
+    {
+    public:
+        ScopedTimer() noexcept
+        { }
+
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+        ~ScopedTimer()
+        { }
+    };
+
+    //////////////////////////////////////
+    // registry of live trace points - snapshots & export
+
+    struct NamedSnapshot
+    {
+        std::string name;
+        HistogramSnapshot histogram;
+    };
+
+    // one snapshot per trace point name (trace points sharing a name are merged)
+    std::vector<NamedSnapshot> snapshot();
+
+    std::optional<HistogramSnapshot> snapshot(std::string_view name);
+
+    // Chrome trace event format (chrome://tracing, Perfetto) - complete events of the Tracing policy
+    void write_chrome_trace(std::ostream& out);
+} // namespace Instrumentation::Timing
+
+#endif
@@ -1,8 +1,18 @@
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <cstdint>
 #include <iostream>
+#include <numeric>
+#include <random>
+#include <stdexcept>
 #include <string>
-#include <vector>
+#include <string_view>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 using namespace std::literals;
 
@@ -17,4 +27,269 @@ constexpr auto unroll = [](auto expr)
 TEST_CASE("loop unrolling")
 {
     unroll<10>([] { std::cout << "Hello World!\n"; });
-}
\ No newline at end of file
+}
+
+//////////////////////////////////////
+// Compile-time perfect hash map
+
+namespace PerfectHash
+{
+    // little-endian word assembled from chars - compiles to a single load, but works in constant evaluation
+    constexpr std::uint64_t load_word(const char* data, size_t size)
+    {
+        std::uint64_t word = 0;
+        for (size_t i = 0; i < size; ++i)
+            word |= std::uint64_t{static_cast<unsigned char>(data[i])} << (8 * i);
+        return word;
+    }
+
+    constexpr std::uint64_t hash(std::string_view key)
+    {
+        std::uint64_t h = 0xcbf29ce484222325 ^ key.size();
+
+        size_t i = 0;
+        for (; i + 8 <= key.size(); i += 8)
+            h = std::rotl((h ^ load_word(key.data() + i, 8)) * 0x100000001b3, 29);
+
+        return (h ^ load_word(key.data() + i, key.size() - i)) * 0x100000001b3;
+    }
+
+    constexpr std::uint64_t mix(std::uint64_t h, std::uint64_t seed)
+    {
+        h ^= seed * 0x9e3779b97f4a7c15;
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccd;
+        h ^= h >> 33;
+        return h;
+    }
+
+    // hash & displace: keys are split into buckets, every bucket gets a seed that sends its keys
+    // to free slots - a lookup is one hash, one mix and one string compare, without branches
+    template <typename T, size_t N>
+    class StaticMap
+    {
+        static_assert(N > 0, "StaticMap needs at least one key - the hash is taken modulo N");
+
+    public:
+        static constexpr size_t bucket_count = N;
+        static constexpr size_t slot_count = std::bit_ceil(N);
+
+    private:
+        std::array<std::uint32_t, bucket_count> seeds{};
+        std::array<std::string_view, slot_count> keys{};
+        std::array<T, slot_count> values{};
+
+        static constexpr size_t slot_of(std::uint64_t h, std::uint32_t seed)
+        {
+            return mix(h, seed) & (slot_count - 1);
+        }
+
+    public:
+        explicit consteval StaticMap(const std::array<std::pair<std::string_view, T>, N>& entries)
+        {
+            std::vector<std::vector<size_t>> buckets(bucket_count);
+            for (size_t i = 0; i < N; ++i)
+                buckets[hash(entries[i].first) % bucket_count].push_back(i);
+
+            std::vector<size_t> order(bucket_count);
+            std::iota(order.begin(), order.end(), 0);
+            std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return buckets[a].size() > buckets[b].size(); });
+
+            std::vector<bool> used(slot_count);
+            std::vector<size_t> slots;
+
+            for (size_t bucket : order)
+            {
+                const auto& items = buckets[bucket];
+                if (items.empty())
+                    break;
+
+                for (std::uint32_t seed = 0;; ++seed)
+                {
+                    if (seed == (1 << 20))
+                        throw "no perfect hash found - duplicated keys?";
+
+                    slots.clear();
+                    for (size_t item : items)
+                    {
+                        const size_t slot = slot_of(hash(entries[item].first), seed);
+                        if (used[slot] || std::find(slots.begin(), slots.end(), slot) != slots.end())
+                            break;
+                        slots.push_back(slot);
+                    }
+
+                    if (slots.size() == items.size())
+                    {
+                        for (size_t i = 0; i < items.size(); ++i)
+                        {
+                            used[slots[i]] = true;
+                            keys[slots[i]] = entries[items[i]].first;
+                            values[slots[i]] = entries[items[i]].second;
+                        }
+                        seeds[bucket] = seed;
+                        break;
+                    }
+                }
+            }
+
+            // a free slot holds a key that lives elsewhere - a single compare rejects every other key
+            for (size_t slot = 0; slot < slot_count; ++slot)
+                if (!used[slot])
+                    keys[slot] = entries[0].first;
+        }
+
+        constexpr const T* find(std::string_view key) const
+        {
+            const std::uint64_t h = hash(key);
+            const size_t slot = slot_of(h, seeds[h % bucket_count]);
+            return keys[slot] == key ? &values[slot] : nullptr;
+        }
+
+        constexpr bool contains(std::string_view key) const
+        {
+            return find(key) != nullptr;
+        }
+
+        constexpr const T& at(std::string_view key) const
+        {
+            if (const T* value = find(key))
+                return *value;
+            throw std::out_of_range("StaticMap - unknown key");
+        }
+
+        static constexpr size_t size()
+        {
+            return N;
+        }
+    };
+
+    template <typename T, size_t N>
+    consteval StaticMap<T, N> make_static_map(const std::array<std::pair<std::string_view, T>, N>& entries)
+    {
+        return StaticMap<T, N>{entries};
+    }
+
+    // value type cannot be deduced from nested braces: make_static_map<int>({{"one", 1}, {"two", 2}})
+    template <typename T, size_t N>
+    consteval StaticMap<T, N> make_static_map(const std::pair<std::string_view, T> (&entries)[N])
+    {
+        return StaticMap<T, N>{std::to_array(entries)};
+    }
+} // namespace PerfectHash
+
+enum class Method
+{
+    get,
+    head,
+    post,
+    put,
+    patch,
+    delete_,
+    options
+};
+
+TEST_CASE("static perfect hash map")
+{
+    using PerfectHash::make_static_map;
+
+    static constexpr auto methods = make_static_map<Method>({{"GET", Method::get},
+        {"HEAD", Method::head},
+        {"POST", Method::post},
+        {"PUT", Method::put},
+        {"PATCH", Method::patch},
+        {"DELETE", Method::delete_},
+        {"OPTIONS", Method::options}});
+
+    static_assert(methods.size() == 7);
+    static_assert(methods.at("PUT") == Method::put);
+    static_assert(*methods.find("OPTIONS") == Method::options);
+    static_assert(!methods.contains("TRACE"));
+    static_assert(!methods.contains(""));
+    static_assert(!methods.contains("get"));
+
+    REQUIRE(methods.at("DELETE") == Method::delete_);
+    REQUIRE_THROWS_AS(methods.at("CONNECT"), std::out_of_range);
+}
+
+// "field_000" ... "field_299" - storage with static duration, so views of it are constant expressions
+namespace Fields
+{
+    constexpr size_t count = 300;
+    constexpr size_t name_length = 9;
+
+    constexpr auto storage = [] {
+        std::array<char, count * name_length> chars{};
+        for (size_t i = 0; i < count; ++i)
+        {
+            const std::string_view prefix = "field_";
+            std::copy(prefix.begin(), prefix.end(), chars.begin() + i * name_length);
+            chars[i * name_length + 6] = static_cast<char>('0' + i / 100);
+            chars[i * name_length + 7] = static_cast<char>('0' + i / 10 % 10);
+            chars[i * name_length + 8] = static_cast<char>('0' + i % 10);
+        }
+        return chars;
+    }();
+
+    constexpr std::string_view name(size_t i)
+    {
+        return {storage.data() + i * name_length, name_length};
+    }
+
+    constexpr auto entries = [] {
+        std::array<std::pair<std::string_view, int>, count> result{};
+        for (size_t i = 0; i < count; ++i)
+            result[i] = {name(i), static_cast<int>(i)};
+        return result;
+    }();
+
+    constexpr auto map = PerfectHash::make_static_map(entries);
+
+    static_assert([] {
+        for (size_t i = 0; i < count; ++i)
+            if (map.at(name(i)) != static_cast<int>(i))
+                return false;
+        return !map.contains("field_300") && !map.contains("field_00");
+    }());
+} // namespace Fields
+
+TEST_CASE("static perfect hash map - benchmarks", "[.][benchmark]")
+{
+    std::unordered_map<std::string, int> unordered;
+    for (const auto& [key, value] : Fields::entries)
+        unordered.emplace(key, value);
+
+    auto sorted = Fields::entries;
+    std::sort(sorted.begin(), sorted.end());
+
+    std::vector<std::string> queries;
+    std::mt19937 rnd{665};
+    std::uniform_int_distribution<size_t> distr(0, Fields::count - 1);
+    for (int i = 0; i < 10'000; ++i)
+        queries.emplace_back(Fields::name(distr(rnd)));
+
+    BENCHMARK("std::unordered_map<std::string, int>")
+    {
+        int sum = 0;
+        for (const auto& query : queries)
+            sum += unordered.find(query)->second;
+        return sum;
+    };
+
+    BENCHMARK("sorted std::array + binary search")
+    {
+        int sum = 0;
+        for (const auto& query : queries)
+            sum += std::lower_bound(sorted.begin(), sorted.end(), std::string_view{query},
+                [](const auto& entry, std::string_view key) { return entry.first < key; })
+                       ->second;
+        return sum;
+    };
+
+    BENCHMARK("PerfectHash::StaticMap")
+    {
+        int sum = 0;
+        for (const auto& query : queries)
+            sum += *Fields::map.find(query);
+        return sum;
+    };
+}
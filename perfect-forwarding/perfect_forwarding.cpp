@@ -1,8 +1,29 @@
+#include "event_waiters.hpp"
 #include "gadget.hpp"
-
+#include "instrumentation.hpp"
+#include "task.hpp"
+#include "thread_pool.hpp"
+#include "timing.hpp"
+
+#include <array>
+#include <atomic>
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <charconv>
+#include <concepts>
+#include <cstring>
 #include <functional>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <sstream>
+#include <string_view>
 #include <vector>
+#include <version>
+
+#ifdef __cpp_lib_format
+#include <format>
+#endif
 
 using namespace std::literals;
 
@@ -72,15 +93,206 @@ namespace Cpp20
     }
 } // namespace Cpp20
 
+namespace Concat
+{
+    template <typename T>
+    concept StringLike = std::convertible_to<const T&, std::string_view>;
+
+    template <typename T>
+    concept Integer = std::integral<T> && !std::same_as<T, char> && !std::same_as<T, bool>;
+
+    template <typename T>
+    concept Piece = StringLike<T> || std::same_as<T, char> || Integer<T>;
+
+    template <Integer T>
+    constexpr size_t digits(T value)
+    {
+        using TUnsigned = std::make_unsigned_t<T>;
+
+        size_t length = value < 0 ? 1 : 0;
+        TUnsigned magnitude = value < 0 ? TUnsigned(0) - static_cast<TUnsigned>(value) : static_cast<TUnsigned>(value);
+        do
+        {
+            ++length;
+            magnitude /= 10;
+        } while (magnitude != 0);
+
+        return length;
+    }
+
+    static_assert(digits(0) == 1);
+    static_assert(digits(-665) == 4);
+    static_assert(digits(std::numeric_limits<int64_t>::min()) == 20);
+
+    template <Piece T>
+    size_t length_of(const T& piece)
+    {
+        if constexpr (std::same_as<T, char>)
+            return 1;
+        else if constexpr (Integer<T>)
+            return digits(piece);
+        else
+            return std::string_view{piece}.size();
+    }
+
+    template <Piece T>
+    char* write(char* dest, const T& piece, size_t length)
+    {
+        if constexpr (std::same_as<T, char>)
+            *dest = piece;
+        else if constexpr (Integer<T>)
+            std::to_chars(dest, dest + length, piece);
+        else
+            std::memcpy(dest, std::string_view{piece}.data(), length);
+
+        return dest + length;
+    }
+
+    // a piece pointing into the text of dest - dangles once dest grows
+    template <Piece T>
+    bool aliases(const std::string& dest, const T& piece)
+    {
+        if constexpr (StringLike<T>)
+        {
+            const char* data = std::string_view{piece}.data();
+            return std::less_equal<>{}(dest.data(), data) && std::less<>{}(data, dest.data() + dest.size());
+        }
+        else
+            return false;
+    }
+
+    // total length is computed in one pass, buffer grows at most once & pieces are written in place
+    template <Piece... TArgs>
+    void write_all(std::string& dest, const TArgs&... args)
+    {
+        const std::array<size_t, sizeof...(TArgs)> lengths{length_of(args)...};
+        const size_t offset = dest.size();
+        const size_t total = std::accumulate(lengths.begin(), lengths.end(), offset);
+
+        dest.resize_and_overwrite(total, [&](char* buffer, size_t size) {
+            char* pos = buffer + offset;
+            size_t index = 0;
+            (..., (pos = write(pos, args, lengths[index++])));
+            return size;
+        });
+    }
+
+    // append_to(s, s) & pieces viewing s are concatenated into a new buffer first
+    template <Piece... TArgs>
+    std::string& append_to(std::string& dest, const TArgs&... args)
+    {
+        if constexpr (sizeof...(TArgs) > 0)
+        {
+            if ((... || aliases(dest, args))) [[unlikely]]
+            {
+                std::string joined;
+                write_all(joined, std::string_view{dest}, args...);
+                dest = std::move(joined);
+            }
+            else
+                write_all(dest, args...);
+        }
+
+        return dest;
+    }
+
+    template <Piece... TArgs>
+    std::string str_concat(const TArgs&... args)
+    {
+        std::string result;
+        append_to(result, args...);
+        return result;
+    }
+} // namespace Concat
+
 std::string get_full_name(const std::string& fn, const std::string& ln)
 {
-    return fn + " " + ln;
+    return Concat::str_concat(fn, ' ', ln);
 }
 
 TEST_CASE("get_full_name")
 {
     std::string name = "Jan";
     std::string full_name = get_full_name(name, "Kowalski");
+    REQUIRE(full_name == "Jan Kowalski");
+}
+
+TEST_CASE("str_concat & append_to")
+{
+    using namespace Concat;
+
+    SECTION("mixed pieces")
+    {
+        std::string_view separator = ":";
+        REQUIRE(str_concat("Hello", std::string("world"), '!') == "Helloworld!");
+        REQUIRE(str_concat("user", separator, 42, separator, -665, separator, 0u) == "user:42:-665:0");
+        REQUIRE(str_concat(std::numeric_limits<int64_t>::min(), ' ', std::numeric_limits<uint64_t>::max())
+            == "-9223372036854775808 18446744073709551615");
+        REQUIRE(str_concat() == "");
+    }
+
+    SECTION("append_to reuses capacity")
+    {
+        std::string key;
+        key.reserve(128);
+        const char* buffer_before = key.data();
+
+        for (int id = 0; id < 3; ++id)
+        {
+            key.clear();
+            append_to(key, "session:", id, ':', "Kowalski");
+        }
+
+        REQUIRE(key == "session:2:Kowalski");
+        REQUIRE(key.data() == buffer_before);
+
+        append_to(key, "-", 665);
+        REQUIRE(key == "session:2:Kowalski-665");
+    }
+
+    SECTION("pieces aliasing dest")
+    {
+        std::string text(20, 'x');
+        text.shrink_to_fit(); // appending reallocates
+
+        append_to(text, text, '-', std::string_view{text}.substr(0, 3), text.c_str());
+        REQUIRE(text == std::string(40, 'x') + "-xxx" + std::string(20, 'x'));
+
+        std::string empty;
+        append_to(empty, empty, std::string_view{empty});
+        REQUIRE(empty.empty());
+    }
+}
+
+TEST_CASE("str_concat & append_to - benchmarks", "[.][benchmark]")
+{
+    const std::string prefix = "tenant-eu-central";
+    const std::string name = "Kowalski-Jan-Maria";
+    int id = 665'042;
+
+    BENCHMARK("operator+ chain")
+    {
+        return prefix + ":" + std::to_string(id) + ":" + name + "!";
+    };
+
+    BENCHMARK("Concat::str_concat")
+    {
+        return Concat::str_concat(prefix, ':', id, ':', name, '!');
+    };
+
+    std::string key;
+    BENCHMARK("Concat::append_to - reused buffer")
+    {
+        key.clear();
+        return Concat::append_to(key, prefix, ':', id, ':', name, '!').size();
+    };
+
+#ifdef __cpp_lib_format
+    BENCHMARK("std::format")
+    {
+        return std::format("{}:{}:{}!", prefix, id, name);
+    };
+#endif
 }
 
 TEST_CASE("custom forwarding")
@@ -93,6 +305,42 @@ TEST_CASE("custom forwarding")
     use(Gadget{3, "temp-gadget"});
 }
 
+TEST_CASE("custom forwarding - copies & moves")
+{
+    using Instrumentation::Event;
+
+    SECTION("temporary is forwarded as rvalue - no copies & no moves")
+    {
+        Instrumentation::Scope scope;
+
+        use(Probe<Gadget>{3, "temp-gadget"});
+
+        const auto counts = scope.counts();
+        REQUIRE(counts[Event::constructed] == 1);
+        REQUIRE(counts.copies() == 0);
+        REQUIRE(counts.moves() == 0);
+        REQUIRE(counts.destructions() == 1);
+        REQUIRE(counts.allocations() == 0);
+    }
+
+    SECTION("lvalues are forwarded as lvalues")
+    {
+        Probe<Gadget> g{1, "gadget"};
+        const Probe<Gadget> cg{2, "const-gadget"};
+
+        Instrumentation::Scope scope;
+
+        use(g);
+        use(cg);
+        Cpp20::use(g);
+
+        const auto counts = scope.counts();
+        REQUIRE(counts.constructions() == 0);
+        REQUIRE(counts.copies() == 0);
+        REQUIRE(counts.moves() == 0);
+    }
+}
+
 template <typename TTracer>
 auto fun_with_tracer(TTracer&& tracer)
 {
@@ -153,6 +401,37 @@ TEST_CASE("lambda + perfect forward")
     auto t3 = fun_with_tracer(Tracer{});
 }
 
+TEST_CASE("lambda + perfect forward - copies & moves")
+{
+    SECTION("lvalue is copied into the lambda")
+    {
+        Probe<std::string> text{"text"};
+
+        Instrumentation::Scope scope;
+        auto result = use_lambda(text);
+
+        REQUIRE(scope.counts().copies() == 1);
+        REQUIRE(scope.counts().moves() == 1); // returned from the lambda
+    }
+
+    SECTION("rvalue is moved - never copied")
+    {
+        Instrumentation::Scope scope;
+        auto result = use_lambda(Probe<std::string>{"text"});
+
+        REQUIRE(scope.counts().copies() == 0);
+        REQUIRE(scope.counts().moves() == 2);
+    }
+
+    SECTION("fun_with_tracer")
+    {
+        Instrumentation::Scope scope;
+        auto result = fun_with_tracer(Probe<std::string>{"text"});
+
+        REQUIRE(scope.counts().copies() == 0);
+    }
+}
+
 namespace ExplainStd
 {
     template <typename T>
@@ -171,24 +450,82 @@ namespace ExplainStd
 }
 
 
-template <typename Signature>
+template <typename Signature, typename TTimingPolicy = Instrumentation::Timing::Disabled>
 class Signal
 {
 private:
+    using Waiters = Coroutines::EventWaitersFor<Signature>;
+
     std::vector<std::function<Signature>> funcs;
+    Waiters waiters;
+
+    template <typename... Args>
+    void call_slots(Args&&... args)
+    {
+        for (auto&& func : funcs)
+            func(std::forward<Args>(args)...); // Bug!!! - many forwards on the same args
+    }
 
 public:
+    Signal() = default;
+
+    // copies & moves take the slots only - coroutines awaiting next() stay registered with the source
+    Signal(const Signal& other)
+        : funcs{other.funcs}
+    { }
+
+    Signal(Signal&& other) noexcept
+        : funcs{std::move(other.funcs)}
+    { }
+
+    Signal& operator=(const Signal& other)
+    {
+        funcs = other.funcs;
+        return *this;
+    }
+
+    Signal& operator=(Signal&& other) noexcept
+    {
+        funcs = std::move(other.funcs);
+        return *this;
+    }
+
     template <typename Function>
     void operator+=(Function&& func)
     {
         funcs.push_back(std::forward<Function>(func));
     }
 
+    // co_await signal.next() - the decayed arguments of the next emission (structured bindings work);
+    // only for copyable arguments - e.g. Signal<void(std::unique_ptr<int>)> has slots only
+    auto next() noexcept
+        requires Waiters::copyable_arguments
+    {
+        return waiters.next();
+    }
+
+    // as above - the awaiting coroutine is resumed by executor.post(...) instead of the emitting thread
+    template <Coroutines::Executor TExecutor>
+        requires Waiters::copyable_arguments
+    auto next(TExecutor& executor) noexcept
+    {
+        return waiters.next(executor);
+    }
+
     template <typename... Args>
     void operator()(Args&&... args)
     {
-        for (auto&& func : funcs)
-            func(std::forward<Args>(args)...); // Bug!!! - many forwards on the same args
+        Instrumentation::Timing::ScopedTimer<TTimingPolicy, "Signal::operator()"> timer;
+
+        if constexpr (Waiters::copyable_arguments)
+        {
+            // copied before the slots - they may move from args; one copy shared by all awaiting coroutines
+            auto emission = waiters.capture(args...);
+            call_slots(std::forward<Args>(args)...);
+            emission.deliver();
+        }
+        else
+            call_slots(std::forward<Args>(args)...);
     }
 };
 
@@ -238,6 +575,277 @@ TEST_CASE("defect2")
     signal(std::make_pair("foo"s, 42));
 }
 
+TEST_CASE("Signal - copies & moves")
+{
+    const Probe<std::string> message{"message"};
+
+    SECTION("slots taking const& - no copies")
+    {
+        Signal<void(const std::string&)> signal;
+        signal += [](const std::string&) { };
+        signal += [](const std::string&) { };
+
+        Instrumentation::Scope scope;
+        signal(message);
+
+        REQUIRE(scope.counts().copies() == 0);
+        REQUIRE(scope.counts().moves() == 0);
+    }
+
+    SECTION("slots taking a value - a copy of lvalue per slot")
+    {
+        Signal<void(Probe<std::string>)> signal;
+        signal += [](Probe<std::string>) { };
+        signal += [](Probe<std::string>) { };
+
+        Instrumentation::Scope scope;
+        signal(message);
+
+        REQUIRE(scope.counts().copies() == 2);
+    }
+
+    SECTION("slots taking a value - rvalue is moved to every slot")
+    {
+        Signal<void(Probe<std::string>)> signal;
+        signal += [](Probe<std::string>) { };
+        signal += [](Probe<std::string>) { }; // gets a moved-from string - see "defect"
+
+        Instrumentation::Scope scope;
+        signal(Probe<std::string>{"message"});
+
+        REQUIRE(scope.counts().copies() == 0);
+    }
+}
+
+TEST_CASE("Signal - timing policy")
+{
+    using namespace Instrumentation;
+
+    Signal<void(int), Timing::Tracing<>> signal;
+    signal += [](int) { };
+
+    for (int i = 0; i < 10; ++i)
+        signal(i);
+
+    const auto snapshot = Timing::snapshot("Signal::operator()");
+    REQUIRE(snapshot.has_value());
+    REQUIRE(snapshot->count == 10);
+
+    std::ostringstream trace;
+    Timing::write_chrome_trace(trace);
+    REQUIRE(trace.str().find("Signal::operator()") != std::string::npos);
+}
+
+namespace
+{
+    template <typename TSignal>
+    concept AwaitableSignal = requires(TSignal& signal) { signal.next(); };
+
+    Coroutines::task<void> collect(Signal<void(const std::string&)>& signal, std::vector<std::string>& received, int count)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            auto [text] = co_await signal.next();
+            received.push_back(text);
+        }
+    }
+} // namespace
+
+TEST_CASE("Signal - awaiting emissions")
+{
+    SECTION("slots & awaiting coroutines get the same arguments")
+    {
+        Signal<void(const std::string&)> signal;
+        std::vector<std::string> from_slot, from_task;
+        signal += [&](const std::string& text) { from_slot.push_back(text); };
+
+        auto task = collect(signal, from_task, 2);
+        task.start();
+
+        signal("one");
+        signal(std::string{"two"});
+        signal("three"); // the task has finished
+
+        REQUIRE(from_slot == std::vector<std::string>{"one", "two", "three"});
+        REQUIRE(from_task == std::vector<std::string>{"one", "two"});
+        REQUIRE(task.done());
+    }
+
+    SECTION("rvalue arguments - one copy for all waiters, intact after the slots moved from them")
+    {
+        Signal<void(Probe<std::string>)> signal;
+        std::vector<std::string> from_slots, from_tasks;
+        signal += [&](Probe<std::string> text) { from_slots.push_back(text); };
+        signal += [&](Probe<std::string> text) { from_slots.push_back(text); }; // gets a moved-from string
+
+        auto waiter = [&]() -> Coroutines::task<void> {
+            auto [text] = co_await signal.next();
+            from_tasks.push_back(text);
+        };
+
+        std::vector<Coroutines::task<void>> tasks;
+        for (int i = 0; i < 3; ++i)
+        {
+            tasks.push_back(waiter());
+            tasks.back().start();
+        }
+
+        Instrumentation::Scope scope;
+        signal(Probe<std::string>{"message"});
+
+        REQUIRE(scope.counts().copies() == 1); // the emission - shared by the 3 tasks
+        REQUIRE(from_slots == std::vector<std::string>{"message", ""});
+        REQUIRE(from_tasks == std::vector<std::string>(3, "message"));
+    }
+
+    SECTION("resumed on a thread pool - arguments outlive the temporary")
+    {
+        Signal<void(const std::string&)> signal;
+        std::vector<Coroutines::task<size_t>> tasks;
+        std::atomic<size_t> sum{0};
+
+        // no captures - the coroutines refer only to their parameters, which outlive the pool
+        auto waiter = [](Signal<void(const std::string&)>& signal, Executors::ThreadPool& pool, std::atomic<size_t>& sum) -> Coroutines::task<size_t> {
+            auto [text] = co_await signal.next(pool);
+            sum += text.size();
+            co_return text.size();
+        };
+
+        {
+            Executors::ThreadPool pool{2};
+
+            for (int i = 0; i < 4; ++i)
+            {
+                tasks.push_back(waiter(signal, pool, sum));
+                tasks.back().start();
+            }
+
+            signal(std::string(100, 't'));
+        } // the workers are joined - every task has finished
+
+        REQUIRE(sum == 400);
+        for (auto& task : tasks)
+            REQUIRE(task.get() == 100);
+    }
+
+    SECTION("copies & moves take the slots - waiters stay with the source")
+    {
+        Signal<void(const std::string&)> signal;
+        std::vector<std::string> from_slot, from_task;
+        signal += [&](const std::string& text) { from_slot.push_back(text); };
+
+        auto task = collect(signal, from_task, 1);
+        task.start();
+
+        Signal<void(const std::string&)> copy = signal;
+        copy("copy");
+        REQUIRE(from_slot == std::vector<std::string>{"copy"});
+        REQUIRE(from_task.empty());
+
+        Signal<void(const std::string&)> moved = std::move(signal);
+        moved("moved");
+        REQUIRE(from_slot == std::vector<std::string>{"copy", "moved"});
+        REQUIRE(from_task.empty());
+
+        signal("source"); // no slots left - only the waiter
+        REQUIRE(from_slot == std::vector<std::string>{"copy", "moved"});
+        REQUIRE(from_task == std::vector<std::string>{"source"});
+        REQUIRE(task.done());
+    }
+
+    SECTION("non-copyable arguments - slots only, no next()")
+    {
+        using UniqueSignal = Signal<void(std::unique_ptr<int>)>;
+        using StreamSignal = Signal<void(std::ostream&)>;
+        static_assert(AwaitableSignal<Signal<void(const std::string&)>>);
+        static_assert(!AwaitableSignal<UniqueSignal>);
+        static_assert(!AwaitableSignal<StreamSignal>);
+
+        UniqueSignal unique_signal;
+        int received = 0;
+        unique_signal += [&](std::unique_ptr<int> ptr) { received = *ptr; };
+        unique_signal(std::make_unique<int>(665));
+        REQUIRE(received == 665);
+
+        StreamSignal stream_signal;
+        stream_signal += [](std::ostream& out) { out << "slot"; };
+        std::ostringstream out;
+        stream_signal(out);
+        REQUIRE(out.str() == "slot");
+    }
+
+    SECTION("a coroutine destroyed while awaiting is not resumed")
+    {
+        Signal<void(const std::string&)> signal;
+        std::vector<std::string> received;
+
+        {
+            auto task = collect(signal, received, 1);
+            task.start();
+        }
+
+        signal("ignored");
+        REQUIRE(received.empty());
+    }
+}
+
+TEST_CASE("Signal - benchmarks", "[.][benchmark]")
+{
+    constexpr int slot_count = 4;
+    const std::string message(64, 'm'); // no SSO - every copy allocates
+
+    size_t received = 0;
+
+    Signal<void(const std::string)> by_value;
+    Signal<void(const std::string&)> by_ref;
+    for (int i = 0; i < slot_count; ++i)
+    {
+        by_value += [&received](const std::string str) { received += str.size(); };
+        by_ref += [&received](const std::string& str) { received += str.size(); };
+    }
+
+    BENCHMARK("emit to 4 slots - void(const std::string) - lvalue")
+    {
+        by_value(message);
+        return received;
+    };
+
+    BENCHMARK("emit to 4 slots - void(const std::string) - const char*")
+    {
+        by_value("message");
+        return received;
+    };
+
+    BENCHMARK("emit to 4 slots - void(const std::string&) - lvalue")
+    {
+        by_ref(message);
+        return received;
+    };
+
+    // resumption latency - the same work in coroutines awaiting signal.next()
+    Signal<void(const std::string&)> awaited;
+    auto listen = [&]() -> Coroutines::task<void> {
+        while (true)
+        {
+            auto [str] = co_await awaited.next();
+            received += str.size();
+        }
+    };
+
+    std::vector<Coroutines::task<void>> listeners;
+    for (int i = 0; i < slot_count; ++i)
+    {
+        listeners.push_back(listen());
+        listeners.back().start();
+    }
+
+    BENCHMARK("emit to 4 awaiting tasks - void(const std::string&) - lvalue")
+    {
+        awaited(message);
+        return received;
+    };
+}
+
 template <typename TArg>
 void perfect_forward_with_bug(TArg&& arg)
 {
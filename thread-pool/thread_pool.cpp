@@ -0,0 +1,254 @@
+#include "thread_pool.hpp"
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#elif defined(_WIN32)
+#include <windows.h>
+#endif
+
+namespace Executors
+{
+    namespace Details
+    {
+        WorkStealingDeque::WorkStealingDeque(int64_t capacity)
+        {
+            buffers.push_back(std::make_unique<Buffer>(std::bit_ceil(static_cast<uint64_t>(capacity))));
+            buffer.store(buffers.back().get(), std::memory_order_relaxed);
+        }
+
+        WorkStealingDeque::Buffer* WorkStealingDeque::grow(Buffer* old, int64_t first, int64_t last)
+        {
+            auto bigger = std::make_unique<Buffer>(old->capacity * 2);
+            for (int64_t i = first; i != last; ++i)
+                bigger->put(i, old->get(i));
+
+            Buffer* result = buffers.emplace_back(std::move(bigger)).get();
+            buffer.store(result, std::memory_order_release);
+            return result;
+        }
+
+        class ThreadPoolState
+        {
+        public:
+            std::vector<std::unique_ptr<Worker>> workers;
+            std::vector<std::thread> threads;
+
+            std::mutex injected_mutex;
+            std::deque<Job*> injected;
+            std::atomic<size_t> injected_count{0};
+
+            // idle workers sleep on wake - a push that sees sleepers bumps epoch & notifies
+            std::mutex sleep_mutex;
+            std::condition_variable wake;
+            std::atomic<size_t> sleepers{0};
+            uint64_t epoch = 0; // guarded by sleep_mutex
+            bool stopping = false; // guarded by sleep_mutex
+
+            void wake_one() noexcept
+            {
+                std::atomic_thread_fence(std::memory_order_seq_cst); // the push before vs sleepers - see sleep()
+                if (sleepers.load(std::memory_order_relaxed) == 0)
+                    return;
+
+                {
+                    std::lock_guard lock{sleep_mutex};
+                    ++epoch;
+                }
+                wake.notify_one();
+            }
+
+            void inject(Job* job)
+            {
+                {
+                    std::lock_guard lock{injected_mutex};
+                    injected.push_back(job);
+                    injected_count.fetch_add(1, std::memory_order_relaxed);
+                }
+                wake_one();
+            }
+
+            Job* take_injected()
+            {
+                if (injected_count.load(std::memory_order_relaxed) == 0)
+                    return nullptr;
+
+                std::lock_guard lock{injected_mutex};
+                if (injected.empty())
+                    return nullptr;
+
+                Job* job = injected.front();
+                injected.pop_front();
+                injected_count.fetch_sub(1, std::memory_order_relaxed);
+                return job;
+            }
+
+            Job* steal(Worker& thief)
+            {
+                // xorshift - a random first victim spreads the thieves
+                thief.random ^= thief.random << 13;
+                thief.random ^= thief.random >> 7;
+                thief.random ^= thief.random << 17;
+
+                const size_t count = workers.size();
+                const size_t first = thief.random % count;
+                for (size_t i = 0; i < count; ++i)
+                {
+                    Worker& victim = *workers[(first + i) % count];
+                    if (&victim == &thief)
+                        continue;
+
+                    if (Job* job = victim.deque.steal())
+                        return job;
+                }
+                return nullptr;
+            }
+
+            Job* find_job(Worker& worker)
+            {
+                if (Job* job = worker.deque.pop())
+                    return job;
+                if (Job* job = take_injected())
+                    return job;
+                return steal(worker);
+            }
+
+            bool has_jobs() const noexcept
+            {
+                if (injected_count.load(std::memory_order_relaxed) > 0)
+                    return true;
+
+                return std::ranges::any_of(workers, [](const auto& worker) { return !worker->deque.empty(); });
+            }
+
+            // returns false when the pool stops & no jobs are left
+            bool sleep()
+            {
+                std::unique_lock lock{sleep_mutex};
+                const uint64_t seen = epoch;
+                sleepers.fetch_add(1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst); // sleepers vs the pushed jobs - see wake_one()
+
+                bool working = true;
+                if (!has_jobs())
+                {
+                    if (stopping)
+                        working = false;
+                    else
+                        wake.wait(lock, [&] { return epoch != seen || stopping; });
+                }
+
+                sleepers.fetch_sub(1, std::memory_order_relaxed);
+                return working;
+            }
+
+            void work(Worker& worker)
+            {
+                current_worker = &worker;
+
+                while (true)
+                {
+                    if (Job* job = find_job(worker))
+                        job->execute(job);
+                    else if (!sleep())
+                        break;
+                }
+
+                current_worker = nullptr;
+            }
+        };
+
+        namespace
+        {
+            void pin_to_cpu(std::thread& thread, size_t cpu)
+            {
+#if defined(__linux__)
+                cpu_set_t cpus;
+                CPU_ZERO(&cpus);
+                CPU_SET(cpu % CPU_SETSIZE, &cpus);
+                pthread_setaffinity_np(thread.native_handle(), sizeof(cpus), &cpus);
+#elif defined(_WIN32)
+                SetThreadAffinityMask(thread.native_handle(), DWORD_PTR{1} << (cpu % (8 * sizeof(DWORD_PTR))));
+#else
+                (void)thread;
+                (void)cpu;
+#endif
+            }
+        } // namespace
+    } // namespace Details
+
+    ThreadPool::ThreadPool(PoolOptions options)
+        : state{std::make_unique<Details::ThreadPoolState>()}
+    {
+        const size_t count = std::max<size_t>(1, options.threads);
+        const size_t cpus = std::max(1u, std::thread::hardware_concurrency());
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            auto worker = std::make_unique<Details::Worker>();
+            worker->pool = state.get();
+            worker->index = i;
+            worker->random = 0x9E3779B97F4A7C15ull * (i + 1);
+            state->workers.push_back(std::move(worker));
+        }
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            state->threads.emplace_back([this, i] { state->work(*state->workers[i]); });
+            if (options.pin_threads)
+                Details::pin_to_cpu(state->threads.back(), i % cpus);
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard lock{state->sleep_mutex};
+            state->stopping = true;
+        }
+        state->wake.notify_all();
+
+        for (auto& thread : state->threads)
+            thread.join();
+    }
+
+    size_t ThreadPool::size() const noexcept
+    {
+        return state->workers.size();
+    }
+
+    bool ThreadPool::on_worker() const noexcept
+    {
+        return Details::current_worker != nullptr && Details::current_worker->pool == state.get();
+    }
+
+    void ThreadPool::schedule(Task task)
+    {
+        auto* job = new Details::TaskJob{std::move(task)};
+
+        if (on_worker())
+        {
+            Details::current_worker->deque.push(job);
+            state->wake_one();
+        }
+        else
+            state->inject(job);
+    }
+
+    void ThreadPool::wake_one() noexcept
+    {
+        state->wake_one();
+    }
+
+    void ThreadPool::wait_for(Details::Worker& worker, const std::atomic<bool>& done) noexcept
+    {
+        // help instead of blocking - the awaited job is either still in our deque or being run by a thief
+        while (!done.load(std::memory_order_acquire))
+        {
+            if (Details::Job* job = state->find_job(worker))
+                job->execute(job);
+            else
+                std::this_thread::yield();
+        }
+    }
+} // namespace Executors
@@ -0,0 +1,518 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Work-stealing thread pool - every worker owns a Chase-Lev deque: it pushes & pops its own jobs
+// at the bottom, idle workers steal from the top of the others. Jobs from threads outside the
+// pool go through a shared injection queue.
+//
+//   Executors::ThreadPool pool{Executors::PoolOptions{.threads = 8, .pin_threads = true}};
+//
+//   std::future<int> answer = pool.submit([](int x) { return x * 2; }, 21);
+//   pool.post([] { log("fire & forget"); });
+//   Executors::parallel_for(pool, 0, n, [&](int i) { out[i] = f(in[i]); });
+//   long sum = Executors::parallel_reduce(pool, data.begin(), data.end(), 0L);
+//
+// parallel_for & parallel_reduce split the range recursively with ThreadPool::join (fork-join):
+// the right half is pushed for thieves, the left half runs in place - split jobs live on the stack.
+
+namespace Executors
+{
+    //////////////////////////////////////
+    // Task - move-only void() callable, stored in place up to inline_size bytes
+
+    class Task
+    {
+    public:
+        static constexpr size_t inline_size = 48;
+
+        template <typename F>
+        static constexpr bool fits_inline = sizeof(F) <= inline_size && alignof(F) <= alignof(std::max_align_t)
+                                         && std::is_nothrow_move_constructible_v<F>;
+
+        Task() noexcept = default;
+
+        template <typename F>
+            requires(!std::same_as<std::remove_cvref_t<F>, Task>) && std::invocable<std::decay_t<F>&>
+        Task(F&& f)
+        {
+            using TFunction = std::decay_t<F>;
+
+            if constexpr (fits_inline<TFunction>)
+            {
+                ::new (static_cast<void*>(storage)) TFunction(std::forward<F>(f));
+                ops = &inline_operations<TFunction>;
+            }
+            else
+            {
+                ::new (static_cast<void*>(storage)) TFunction*(new TFunction(std::forward<F>(f)));
+                ops = &heap_operations<TFunction>;
+            }
+        }
+
+        Task(Task&& other) noexcept
+        {
+            if (other.ops)
+            {
+                other.ops->relocate(other.storage, storage);
+                ops = std::exchange(other.ops, nullptr);
+            }
+        }
+
+        Task& operator=(Task&& other) noexcept
+        {
+            if (this != &other)
+            {
+                reset();
+                if (other.ops)
+                {
+                    other.ops->relocate(other.storage, storage);
+                    ops = std::exchange(other.ops, nullptr);
+                }
+            }
+            return *this;
+        }
+
+        Task(const Task&) = delete;
+        Task& operator=(const Task&) = delete;
+
+        ~Task()
+        {
+            reset();
+        }
+
+        void operator()()
+        {
+            ops->invoke(storage);
+        }
+
+        explicit operator bool() const noexcept
+        {
+            return ops != nullptr;
+        }
+
+    private:
+        struct Operations
+        {
+            void (*invoke)(void* storage);
+            void (*relocate)(void* from, void* to) noexcept;
+            void (*destroy)(void* storage) noexcept;
+        };
+
+        template <typename TFunction>
+        static constexpr Operations inline_operations{
+            [](void* storage) { (*std::launder(static_cast<TFunction*>(storage)))(); },
+            [](void* from, void* to) noexcept {
+                TFunction* source = std::launder(static_cast<TFunction*>(from));
+                ::new (to) TFunction(std::move(*source));
+                source->~TFunction();
+            },
+            [](void* storage) noexcept { std::launder(static_cast<TFunction*>(storage))->~TFunction(); }};
+
+        template <typename TFunction>
+        static constexpr Operations heap_operations{
+            [](void* storage) { (**std::launder(static_cast<TFunction**>(storage)))(); },
+            [](void* from, void* to) noexcept { ::new (to) TFunction*(*std::launder(static_cast<TFunction**>(from))); },
+            [](void* storage) noexcept { delete *std::launder(static_cast<TFunction**>(storage)); }};
+
+        void reset() noexcept
+        {
+            if (ops)
+                std::exchange(ops, nullptr)->destroy(storage);
+        }
+
+        alignas(std::max_align_t) std::byte storage[inline_size];
+        const Operations* ops = nullptr;
+    };
+
+    static_assert(sizeof(Task) <= 64);
+
+    namespace Details
+    {
+        //////////////////////////////////////
+        // jobs - what the deques hold
+
+        struct Job
+        {
+            void (*execute)(Job* self) noexcept;
+        };
+
+        // a submitted Task - heap allocated, deleted after it ran
+        struct TaskJob : Job
+        {
+            Task task;
+
+            explicit TaskJob(Task&& task)
+                : Job{&TaskJob::run}
+                , task{std::move(task)}
+            { }
+
+            static void run(Job* self) noexcept
+            {
+                auto* job = static_cast<TaskJob*>(self);
+                job->task(); // submit() catches for the future, post() requires a non-throwing callable
+                delete job;
+            }
+        };
+
+        // a half of a fork-join - lives on the stack of the forking worker until done
+        template <typename F>
+        struct ForkJob : Job
+        {
+            F& function;
+            std::exception_ptr error;
+            std::atomic<bool> done{false};
+
+            explicit ForkJob(F& function)
+                : Job{&ForkJob::run}
+                , function{function}
+            { }
+
+            static void run(Job* self) noexcept
+            {
+                auto* job = static_cast<ForkJob*>(self);
+
+                try
+                {
+                    job->function();
+                }
+                catch (...)
+                {
+                    job->error = std::current_exception();
+                }
+
+                job->done.store(true, std::memory_order_release); // the last access - *job may be gone right after
+            }
+        };
+
+        //////////////////////////////////////
+        // Chase-Lev work-stealing deque (Le, Pop, Cohen & Zappa Nardelli, PPoPP 2013)
+        // push & pop - owner thread only, steal - any thread
+
+        class WorkStealingDeque
+        {
+            struct Buffer
+            {
+                int64_t capacity;
+                std::unique_ptr<std::atomic<Job*>[]> slots;
+
+                explicit Buffer(int64_t capacity)
+                    : capacity{capacity}
+                    , slots{new std::atomic<Job*>[static_cast<size_t>(capacity)]}
+                { }
+
+                Job* get(int64_t index) const noexcept
+                {
+                    return slots[static_cast<size_t>(index & (capacity - 1))].load(std::memory_order_relaxed);
+                }
+
+                void put(int64_t index, Job* job) noexcept
+                {
+                    slots[static_cast<size_t>(index & (capacity - 1))].store(job, std::memory_order_relaxed);
+                }
+            };
+
+            alignas(64) std::atomic<int64_t> top{0};
+            alignas(64) std::atomic<int64_t> bottom{0};
+            std::atomic<Buffer*> buffer;
+            std::vector<std::unique_ptr<Buffer>> buffers; // retired buffers may still be read by thieves
+
+            Buffer* grow(Buffer* old, int64_t first, int64_t last);
+
+        public:
+            explicit WorkStealingDeque(int64_t capacity = 256);
+
+            WorkStealingDeque(const WorkStealingDeque&) = delete;
+            WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+            void push(Job* job)
+            {
+                const int64_t b = bottom.load(std::memory_order_relaxed);
+                const int64_t t = top.load(std::memory_order_acquire);
+                Buffer* a = buffer.load(std::memory_order_relaxed);
+
+                if (b - t > a->capacity - 1) [[unlikely]]
+                    a = grow(a, t, b);
+
+                a->put(b, job);
+                bottom.store(b + 1, std::memory_order_release);
+            }
+
+            Job* pop() noexcept
+            {
+                const int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+                Buffer* a = buffer.load(std::memory_order_relaxed);
+                bottom.store(b, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                int64_t t = top.load(std::memory_order_relaxed);
+
+                if (t > b)
+                {
+                    bottom.store(b + 1, std::memory_order_relaxed);
+                    return nullptr;
+                }
+
+                Job* job = a->get(b);
+                if (t == b) // the last job - race with thieves
+                {
+                    if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                        job = nullptr;
+                    bottom.store(b + 1, std::memory_order_relaxed);
+                }
+                return job;
+            }
+
+            Job* steal() noexcept
+            {
+                int64_t t = top.load(std::memory_order_acquire);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                const int64_t b = bottom.load(std::memory_order_acquire);
+
+                if (t >= b)
+                    return nullptr;
+
+                Buffer* a = buffer.load(std::memory_order_acquire);
+                Job* job = a->get(t);
+                if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                    return nullptr; // lost the race - the caller tries elsewhere
+                return job;
+            }
+
+            bool empty() const noexcept
+            {
+                return bottom.load(std::memory_order_relaxed) <= top.load(std::memory_order_relaxed);
+            }
+        };
+
+        class ThreadPoolState;
+
+        struct alignas(64) Worker
+        {
+            WorkStealingDeque deque;
+            ThreadPoolState* pool = nullptr;
+            size_t index = 0;
+            uint64_t random = 0;
+        };
+
+        inline constinit thread_local Worker* current_worker = nullptr;
+    } // namespace Details
+
+    struct PoolOptions
+    {
+        size_t threads = std::max(1u, std::thread::hardware_concurrency());
+        bool pin_threads = false; // worker i runs on CPU i % hardware_concurrency (Linux & Windows)
+    };
+
+    class ThreadPool
+    {
+    public:
+        explicit ThreadPool(PoolOptions options = {});
+
+        explicit ThreadPool(size_t threads)
+            : ThreadPool{PoolOptions{.threads = threads}}
+        { }
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        // runs the jobs still queued, then stops the workers
+        ~ThreadPool();
+
+        size_t size() const noexcept;
+
+        // f(args...) on a worker - the callable & arguments are stored in place in the job (up to Task::inline_size bytes)
+        template <typename F, typename... TArgs>
+            requires std::invocable<std::decay_t<F>, std::decay_t<TArgs>...>
+        auto submit(F&& f, TArgs&&... args) -> std::future<std::invoke_result_t<std::decay_t<F>, std::decay_t<TArgs>...>>
+        {
+            using TResult = std::invoke_result_t<std::decay_t<F>, std::decay_t<TArgs>...>;
+
+            std::promise<TResult> promise;
+            std::future<TResult> result = promise.get_future();
+
+            schedule(Task{[promise = std::move(promise), f = std::forward<F>(f), ... args = std::forward<TArgs>(args)]() mutable {
+                try
+                {
+                    if constexpr (std::is_void_v<TResult>)
+                    {
+                        std::invoke(std::move(f), std::move(args)...);
+                        promise.set_value();
+                    }
+                    else
+                        promise.set_value(std::invoke(std::move(f), std::move(args)...));
+                }
+                catch (...)
+                {
+                    promise.set_exception(std::current_exception());
+                }
+            }});
+
+            return result;
+        }
+
+        // fire & forget - f() on a worker, no future; an exception escaping f terminates
+        template <typename F>
+            requires std::invocable<std::decay_t<F>&>
+        void post(F&& f)
+        {
+            schedule(Task{std::forward<F>(f)});
+        }
+
+        // runs f on a worker of this pool (in place when called from one) and waits - rethrows its exception
+        template <typename F>
+        void run(F&& f)
+        {
+            if (on_worker())
+                f();
+            else
+                submit([&f] { f(); }).get();
+        }
+
+        // fork-join - b may be stolen by another worker while a runs in place; returns when both finished
+        template <typename FA, typename FB>
+        void join(FA&& a, FB&& b)
+        {
+            if (!on_worker())
+            {
+                run([&] { join(a, b); });
+                return;
+            }
+
+            Details::Worker& worker = *Details::current_worker;
+            Details::ForkJob<std::remove_reference_t<FB>> job_b{b};
+            worker.deque.push(&job_b);
+            wake_one();
+
+            std::exception_ptr error_a;
+            try
+            {
+                a();
+            }
+            catch (...)
+            {
+                error_a = std::current_exception();
+            }
+
+            wait_for(worker, job_b.done);
+
+            if (error_a)
+                std::rethrow_exception(error_a);
+            if (job_b.error)
+                std::rethrow_exception(job_b.error);
+        }
+
+    private:
+        std::unique_ptr<Details::ThreadPoolState> state;
+
+        bool on_worker() const noexcept;
+        void schedule(Task task);
+        void wake_one() noexcept;
+        void wait_for(Details::Worker& worker, const std::atomic<bool>& done) noexcept;
+    };
+
+    //////////////////////////////////////
+    // parallel algorithms
+
+    namespace Details
+    {
+        inline size_t default_grain(const ThreadPool& pool, size_t size)
+        {
+            return std::max<size_t>(1, size / (8 * pool.size())); // ~8 blocks per worker for the load balancing
+        }
+
+        template <typename TIndex, typename F>
+        void split_blocks(ThreadPool& pool, TIndex first, TIndex last, F& f, size_t grain)
+        {
+            if (static_cast<size_t>(last - first) <= grain)
+            {
+                f(first, last);
+                return;
+            }
+
+            const TIndex middle = first + (last - first) / 2;
+            pool.join([&] { split_blocks(pool, first, middle, f, grain); }, [&] { split_blocks(pool, middle, last, f, grain); });
+        }
+
+        template <typename It, typename T, typename TReduce>
+        T reduce_blocks(ThreadPool& pool, It first, It last, TReduce& reduce, size_t grain)
+        {
+            if (static_cast<size_t>(last - first) <= grain)
+            {
+                T result(*first);
+                for (++first; first != last; ++first)
+                    result = reduce(std::move(result), *first);
+                return result;
+            }
+
+            const It middle = first + (last - first) / 2;
+            std::optional<T> left, right;
+            pool.join([&] { left.emplace(reduce_blocks<It, T>(pool, first, middle, reduce, grain)); },
+                [&] { right.emplace(reduce_blocks<It, T>(pool, middle, last, reduce, grain)); });
+            return reduce(std::move(*left), std::move(*right));
+        }
+    } // namespace Details
+
+    // f(block_first, block_last) for consecutive blocks covering [first, last) - blocks of up to grain indices
+    template <std::integral TIndex, typename F>
+        requires std::invocable<F&, TIndex, TIndex>
+    void parallel_for_blocks(ThreadPool& pool, TIndex first, TIndex last, F&& f, size_t grain = 0)
+    {
+        if (first >= last)
+            return;
+
+        if (grain == 0)
+            grain = Details::default_grain(pool, static_cast<size_t>(last - first));
+
+        pool.run([&] { Details::split_blocks(pool, first, last, f, grain); });
+    }
+
+    // f(i) for every i in [first, last)
+    template <std::integral TIndex, typename F>
+        requires std::invocable<F&, TIndex>
+    void parallel_for(ThreadPool& pool, TIndex first, TIndex last, F&& f, size_t grain = 0)
+    {
+        parallel_for_blocks(
+            pool, first, last,
+            [&f](TIndex block_first, TIndex block_last) {
+                for (TIndex i = block_first; i != block_last; ++i)
+                    f(i);
+            },
+            grain);
+    }
+
+    // reduce(... reduce(reduce(init, x0), x1) ..., xn) in unspecified grouping - reduce has to be associative
+    template <std::random_access_iterator It, typename T, typename TReduce = std::plus<>>
+    T parallel_reduce(ThreadPool& pool, It first, It last, T init, TReduce reduce = {}, size_t grain = 0)
+    {
+        if (first == last)
+            return init;
+
+        if (grain == 0)
+            grain = Details::default_grain(pool, static_cast<size_t>(last - first));
+
+        std::optional<T> result;
+        pool.run([&] { result.emplace(Details::reduce_blocks<It, T>(pool, first, last, reduce, grain)); });
+        return reduce(std::move(init), std::move(*result));
+    }
+} // namespace Executors
+
+#endif
@@ -0,0 +1,295 @@
+#include "thread_pool.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <array>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Executors;
+
+TEST_CASE("task - small buffer")
+{
+    SECTION("small callables are stored in place")
+    {
+        int counter = 0;
+        auto increment = [&counter] { ++counter; };
+        static_assert(Task::fits_inline<decltype(increment)>);
+
+        Task task{increment};
+        task();
+        task();
+
+        REQUIRE(counter == 2);
+    }
+
+    SECTION("large callables go to the heap")
+    {
+        std::array<int, 64> data{};
+        int sum = -1;
+        auto large = [data, &sum] { sum = std::accumulate(data.begin(), data.end(), 0); };
+        static_assert(!Task::fits_inline<decltype(large)>);
+
+        Task task{large};
+        Task moved{std::move(task)};
+        moved();
+
+        REQUIRE(!task);
+        REQUIRE(sum == 0);
+    }
+
+    SECTION("move-only callables")
+    {
+        auto value = std::make_unique<int>(42);
+        int result = 0;
+
+        Task task{[value = std::move(value), &result] { result = *value; }};
+        Task other;
+        other = std::move(task);
+        other();
+
+        REQUIRE(result == 42);
+    }
+}
+
+TEST_CASE("thread pool - submit")
+{
+    ThreadPool pool{4};
+    REQUIRE(pool.size() == 4);
+
+    SECTION("returns the result through a future")
+    {
+        std::future<int> answer = pool.submit([](int x) { return x * 2; }, 21);
+        REQUIRE(answer.get() == 42);
+    }
+
+    SECTION("void callables")
+    {
+        std::atomic<int> counter{0};
+        std::vector<std::future<void>> done;
+        for (int i = 0; i < 100; ++i)
+            done.push_back(pool.submit([&counter] { ++counter; }));
+
+        for (auto& f : done)
+            f.get();
+
+        REQUIRE(counter == 100);
+    }
+
+    SECTION("exceptions are propagated to the future")
+    {
+        std::future<int> result = pool.submit([]() -> int { throw std::runtime_error{"error"}; });
+        REQUIRE_THROWS_AS(result.get(), std::runtime_error);
+    }
+
+    SECTION("move-only arguments")
+    {
+        std::future<int> result = pool.submit([](std::unique_ptr<int> ptr) { return *ptr; }, std::make_unique<int>(665));
+        REQUIRE(result.get() == 665);
+    }
+
+    SECTION("submits from many threads")
+    {
+        std::atomic<int> counter{0};
+        std::vector<std::thread> producers;
+        for (int t = 0; t < 4; ++t)
+            producers.emplace_back([&] {
+                std::vector<std::future<void>> done;
+                for (int i = 0; i < 1'000; ++i)
+                    done.push_back(pool.submit([&counter] { counter.fetch_add(1, std::memory_order_relaxed); }));
+                for (auto& f : done)
+                    f.get();
+            });
+
+        for (auto& producer : producers)
+            producer.join();
+
+        REQUIRE(counter == 4'000);
+    }
+
+    SECTION("jobs submitted from a worker")
+    {
+        std::future<int> outer = pool.submit([&pool] {
+            std::future<int> inner = pool.submit([] { return 1; }); // pushed to this worker's deque - stolen by another one
+            int a = 0, b = 0;
+            pool.join([&] { a = 2; }, [&] { b = 3; });
+            return a + b + inner.get();
+        });
+
+        REQUIRE(outer.get() == 6);
+    }
+}
+
+TEST_CASE("thread pool - destructor runs the queued jobs")
+{
+    std::atomic<int> counter{0};
+
+    {
+        ThreadPool pool{2};
+        for (int i = 0; i < 1'000; ++i)
+            pool.submit([&counter] { counter.fetch_add(1, std::memory_order_relaxed); });
+    }
+
+    REQUIRE(counter == 1'000);
+}
+
+TEST_CASE("thread pool - pinned threads")
+{
+    ThreadPool pool{PoolOptions{.threads = 2, .pin_threads = true}};
+
+    REQUIRE(pool.submit([] { return 42; }).get() == 42);
+}
+
+TEST_CASE("thread pool - join")
+{
+    ThreadPool pool{4};
+
+    SECTION("runs both halves")
+    {
+        int a = 0, b = 0;
+        pool.join([&] { a = 1; }, [&] { b = 2; });
+
+        REQUIRE(a == 1);
+        REQUIRE(b == 2);
+    }
+
+    SECTION("nested")
+    {
+        std::function<long(int)> fibonacci = [&](int n) -> long {
+            if (n < 2)
+                return n;
+
+            long x = 0, y = 0;
+            pool.join([&] { x = fibonacci(n - 1); }, [&] { y = fibonacci(n - 2); });
+            return x + y;
+        };
+
+        long result = 0;
+        pool.run([&] { result = fibonacci(20); });
+
+        REQUIRE(result == 6765);
+    }
+
+    SECTION("exceptions of both halves are rethrown")
+    {
+        REQUIRE_THROWS_AS(pool.join([] { throw std::runtime_error{"a"}; }, [] { }), std::runtime_error);
+        REQUIRE_THROWS_AS(pool.join([] { }, [] { throw std::logic_error{"b"}; }), std::logic_error);
+    }
+}
+
+TEST_CASE("thread pool - parallel_for")
+{
+    ThreadPool pool{4};
+
+    SECTION("every index is visited exactly once")
+    {
+        std::vector<std::atomic<int>> visits(10'007);
+
+        parallel_for(pool, size_t{0}, visits.size(), [&](size_t i) { visits[i].fetch_add(1, std::memory_order_relaxed); }, 16);
+
+        REQUIRE(std::ranges::all_of(visits, [](const auto& v) { return v.load() == 1; }));
+    }
+
+    SECTION("blocks are consecutive & limited by grain")
+    {
+        std::atomic<int> covered{0};
+        std::atomic<bool> too_large{false};
+
+        parallel_for_blocks(pool, -500, 500, [&](int first, int last) {
+            covered += last - first;
+            if (last - first > 10)
+                too_large = true;
+        }, 10);
+
+        REQUIRE(covered == 1'000);
+        REQUIRE_FALSE(too_large);
+    }
+
+    SECTION("empty range")
+    {
+        bool called = false;
+        parallel_for(pool, 10, 10, [&](int) { called = true; });
+
+        REQUIRE_FALSE(called);
+    }
+
+    SECTION("exceptions are rethrown")
+    {
+        auto fail = [](int i) {
+            if (i == 777)
+                throw std::out_of_range{"777"};
+        };
+
+        REQUIRE_THROWS_AS(parallel_for(pool, 0, 1'000, fail, 8), std::out_of_range);
+    }
+}
+
+TEST_CASE("thread pool - parallel_reduce")
+{
+    ThreadPool pool{4};
+
+    SECTION("sum")
+    {
+        std::vector<int> data(100'000);
+        std::iota(data.begin(), data.end(), 0);
+
+        const long sum = parallel_reduce(pool, data.begin(), data.end(), 0L);
+
+        REQUIRE(sum == std::accumulate(data.begin(), data.end(), 0L));
+    }
+
+    SECTION("the order of the elements is kept - non-commutative operation")
+    {
+        std::vector<std::string> words;
+        for (int i = 0; i < 1'000; ++i)
+            words.push_back(std::to_string(i % 10));
+
+        const std::string text = parallel_reduce(pool, words.begin(), words.end(), std::string{">"}, std::plus<>{}, 7);
+
+        REQUIRE(text == std::accumulate(words.begin(), words.end(), std::string{">"}));
+    }
+
+    SECTION("empty range returns init")
+    {
+        std::vector<int> empty;
+        REQUIRE(parallel_reduce(pool, empty.begin(), empty.end(), 42) == 42);
+    }
+}
+
+TEST_CASE("thread pool - benchmarks", "[.][benchmark]")
+{
+    std::vector<int> data(10'000'000);
+    std::iota(data.begin(), data.end(), 0);
+
+    BENCHMARK("std::accumulate")
+    {
+        return std::accumulate(data.begin(), data.end(), 0L);
+    };
+
+    ThreadPool single{1};
+    BENCHMARK("submit & wait - empty job")
+    {
+        single.submit([] { }).get();
+    };
+
+    // scaling - 1, 2, 4, ... up to hardware_concurrency workers
+    const size_t max_threads = std::max(1u, std::thread::hardware_concurrency());
+    for (size_t threads = 1; threads <= max_threads; threads *= 2)
+    {
+        ThreadPool pool{threads};
+        const std::string suffix = " - " + std::to_string(threads) + " threads";
+
+        BENCHMARK("parallel_reduce" + suffix)
+        {
+            return parallel_reduce(pool, data.begin(), data.end(), 0L);
+        };
+
+        BENCHMARK("parallel_for" + suffix)
+        {
+            parallel_for(pool, size_t{0}, data.size(), [&](size_t i) { data[i] = data[i] * 3 + 1; });
+        };
+    }
+}
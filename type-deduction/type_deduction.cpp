@@ -1,10 +1,21 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 
 #include <algorithm>
+#include <array>
+#include <cctype>
 #include <iostream>
+#include <iterator>
+#include <limits>
 #include <memory>
 #include <numeric>
+#include <random>
+#include <ranges>
+#include <span>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <tuple>
 #include <vector>
 
 using namespace std;
@@ -132,6 +143,257 @@ TEST_CASE("passing by ref")
     REQUIRE("text!!!");
 }
 
+namespace MoveAware
+{
+    template <typename T>
+    std::remove_cvref_t<T> process(T&& arg)
+    {
+        arg += "!!!";
+        return std::forward<T>(arg); // lvalue - copy, rvalue - move
+    }
+} // namespace MoveAware
+
+namespace Pipeline
+{
+    // stage transforms text in place & reports how it changes the size of text
+    template <typename TStage, typename TText = std::string>
+    concept Stage = requires(const TStage& stage, TText&& text, size_t size) {
+        { stage(std::move(text)) } -> std::same_as<TText>;
+        { stage.size_hint(size) } -> std::convertible_to<size_t>;
+    };
+
+    struct Append
+    {
+        std::string suffix;
+
+        template <typename TText>
+        std::remove_cvref_t<TText> operator()(TText&& text) const
+        {
+            text += suffix;
+            return std::forward<TText>(text);
+        }
+
+        size_t size_hint(size_t size) const
+        {
+            return size + suffix.size();
+        }
+    };
+
+    struct ToUpper
+    {
+        template <typename TText>
+        std::remove_cvref_t<TText> operator()(TText&& text) const
+        {
+            for (char& c : text)
+                c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+            return std::forward<TText>(text);
+        }
+
+        size_t size_hint(size_t size) const
+        {
+            return size;
+        }
+    };
+
+    template <typename... TStages>
+    class Chain
+    {
+        std::tuple<TStages...> stages;
+
+    public:
+        explicit Chain(TStages... stages)
+            : stages{std::move(stages)...}
+        { }
+
+        size_t size_hint(size_t size) const
+        {
+            std::apply([&size](const auto&... stage) { (..., (size = stage.size_hint(size))); }, stages);
+            return size;
+        }
+
+        // lvalue text is copied once into buffer of final size, rvalue text is moved through all stages
+        template <typename TText>
+            requires (... && Stage<TStages, std::remove_cvref_t<TText>>)
+        std::remove_cvref_t<TText> operator()(TText&& text) const
+        {
+            using Text = std::remove_cvref_t<TText>;
+
+            const size_t final_size = size_hint(std::size(text));
+            Text result;
+
+            if constexpr (std::is_lvalue_reference_v<TText>)
+            {
+                result.reserve(final_size);
+                result = text; // copy assignment reuses reserved capacity
+            }
+            else
+            {
+                result = std::move(text);
+                result.reserve(final_size);
+            }
+
+            std::apply([&result](const auto&... stage) { (..., (result = stage(std::move(result)))); }, stages);
+
+            return result;
+        }
+    };
+} // namespace Pipeline
+
+struct TracedText
+{
+    inline static size_t copies{};
+    inline static size_t moves{};
+    inline static size_t reallocations{};
+
+    std::string text;
+
+    TracedText() = default;
+
+    TracedText(std::string text)
+        : text{std::move(text)}
+    { }
+
+    TracedText(const TracedText& other)
+        : text{other.text}
+    {
+        ++copies;
+    }
+
+    TracedText(TracedText&& other) noexcept
+        : text{std::move(other.text)}
+    {
+        ++moves;
+    }
+
+    TracedText& operator=(const TracedText& other)
+    {
+        text = other.text;
+        ++copies;
+        return *this;
+    }
+
+    TracedText& operator=(TracedText&& other) noexcept
+    {
+        text = std::move(other.text);
+        ++moves;
+        return *this;
+    }
+
+    static void reset()
+    {
+        copies = moves = reallocations = 0;
+    }
+
+    TracedText& operator+=(std::string_view suffix)
+    {
+        const auto capacity_before = text.capacity();
+        text += suffix;
+        if (text.capacity() != capacity_before)
+            ++reallocations;
+        return *this;
+    }
+
+    void reserve(size_t size)
+    {
+        text.reserve(size);
+    }
+
+    size_t size() const
+    {
+        return text.size();
+    }
+
+    auto begin()
+    {
+        return text.begin();
+    }
+
+    auto end()
+    {
+        return text.end();
+    }
+};
+
+TEST_CASE("move-aware process pipeline")
+{
+    SECTION("MoveAware::process")
+    {
+        TracedText::reset();
+
+        TracedText txt{"text"s};
+        TracedText result_1 = MoveAware::process(txt);
+        CHECK(TracedText::copies == 1);
+
+        TracedText result_2 = MoveAware::process(TracedText{"text"s});
+        CHECK(TracedText::copies == 1);
+        CHECK(result_2.text == "text!!!");
+    }
+
+    Pipeline::Chain pipeline{Pipeline::ToUpper{}, Pipeline::Append{"!!!"}, Pipeline::Append{" - processed"}};
+    REQUIRE(pipeline.size_hint(4) == 4 + 3 + 12);
+
+    SECTION("rvalue - moved through stages without copies")
+    {
+        TracedText::reset();
+
+        TracedText result = pipeline(TracedText{"text"s});
+
+        CHECK(result.text == "TEXT!!! - processed");
+        CHECK(TracedText::copies == 0);
+        CHECK(TracedText::reallocations == 0);
+    }
+
+    SECTION("lvalue - exactly one copy, input is not modified")
+    {
+        TracedText::reset();
+
+        TracedText input{"text"s};
+        TracedText result = pipeline(input);
+
+        CHECK(result.text == "TEXT!!! - processed");
+        CHECK(input.text == "text");
+        CHECK(TracedText::copies == 1);
+        CHECK(TracedText::reallocations == 0);
+    }
+
+    SECTION("std::string")
+    {
+        std::string result = pipeline(get_text());
+        CHECK(result == "TEXT!!! - processed");
+    }
+}
+
+TEST_CASE("move-aware process pipeline - benchmarks", "[.][benchmark]")
+{
+    Pipeline::Chain pipeline{Pipeline::Append{"!!!"}, Pipeline::Append{"!!!"}, Pipeline::Append{"!!!"}};
+
+    for (size_t size : {1024u, 64 * 1024u, 1024 * 1024u})
+    {
+        const std::string input(size, 'x');
+        const std::string suffix = " - " + std::to_string(size / 1024) + " KB";
+
+        BENCHMARK("process() x 3 - rvalue" + suffix)
+        {
+            return process(process(process(std::string{input})));
+        };
+
+        BENCHMARK("MoveAware::process() x 3 - rvalue" + suffix)
+        {
+            return MoveAware::process(MoveAware::process(MoveAware::process(std::string{input})));
+        };
+
+        BENCHMARK("Pipeline::Chain - rvalue" + suffix)
+        {
+            return pipeline(std::string{input});
+        };
+
+        BENCHMARK("Pipeline::Chain - lvalue" + suffix)
+        {
+            return pipeline(input);
+        };
+    }
+}
+
 template <typename TContainer>
 decltype(auto) get_nth(TContainer& container, size_t index)
 {
@@ -155,4 +417,407 @@ TEST_CASE("decltype(auto)")
     REQUIRE(flags[2] == false);
 
     decltype(auto) nth_item = get_nth(flags, 0);
-}
\ No newline at end of file
+}
+
+/////////////////////////////
+// non-owning views - get_nth family
+
+namespace Views
+{
+    struct Unchecked
+    {
+        static void check_index(size_t, size_t) noexcept
+        { }
+
+        static void check_range(size_t, size_t, size_t) noexcept
+        { }
+    };
+
+    struct Checked
+    {
+        static void check_index(size_t index, size_t size)
+        {
+            if (index >= size)
+                throw std::out_of_range("index " + std::to_string(index) + " out of range for size " + std::to_string(size));
+        }
+
+        static void check_range(size_t first, size_t count, size_t size)
+        {
+            if (first > size || count > size - first)
+                throw std::out_of_range("range [" + std::to_string(first) + ", " + std::to_string(first + count) + ") out of range for size " + std::to_string(size));
+        }
+    };
+
+    template <typename TBoundsPolicy = Unchecked, typename TContainer>
+    decltype(auto) get_nth(TContainer& container, size_t index)
+    {
+        TBoundsPolicy::check_index(index, std::size(container));
+        return container[index];
+    }
+
+    // raw pointer for contiguous containers, container's iterator otherwise (e.g. packed bits of std::vector<bool>)
+    template <typename TContainer>
+    auto view_begin(TContainer& container)
+    {
+        if constexpr (std::contiguous_iterator<decltype(std::begin(container))>)
+            return std::data(container);
+        else
+            return std::begin(container);
+    }
+
+    template <typename TContainer>
+    using ViewIterator_t = decltype(view_begin(std::declval<TContainer&>()));
+
+    template <typename TBoundsPolicy = Unchecked, typename TContainer>
+        requires std::random_access_iterator<ViewIterator_t<TContainer>>
+    auto slice(TContainer& container, size_t first, size_t count)
+    {
+        TBoundsPolicy::check_range(first, count, std::size(container));
+
+        auto it = view_begin(container) + first;
+
+        if constexpr (std::is_pointer_v<decltype(it)>)
+            return std::span{it, count};
+        else
+            return std::ranges::subrange{it, it + count}; // std::vector<bool> stays packed - no copy to bools
+    }
+
+    template <std::random_access_iterator It, typename TBoundsPolicy = Unchecked>
+    class StrideView : public std::ranges::view_interface<StrideView<It, TBoundsPolicy>>
+    {
+        It base{};
+        size_t count{};
+        size_t step{1};
+
+    public:
+        class iterator
+        {
+            It base{};
+            size_t index{};
+            size_t step{1};
+
+        public:
+            using value_type = std::iter_value_t<It>;
+            using difference_type = std::ptrdiff_t;
+
+            iterator() = default;
+
+            iterator(It base, size_t index, size_t step)
+                : base{base}
+                , index{index}
+                , step{step}
+            { }
+
+            decltype(auto) operator*() const
+            {
+                return base[index * step];
+            }
+
+            iterator& operator++()
+            {
+                ++index;
+                return *this;
+            }
+
+            iterator operator++(int)
+            {
+                auto temp = *this;
+                ++index;
+                return temp;
+            }
+
+            bool operator==(const iterator& other) const
+            {
+                return index == other.index;
+            }
+        };
+
+        StrideView() = default;
+
+        StrideView(It base, size_t count, size_t step)
+            : base{base}
+            , count{count}
+            , step{step}
+        { }
+
+        iterator begin() const
+        {
+            return {base, 0, step};
+        }
+
+        iterator end() const
+        {
+            return {base, count, step};
+        }
+
+        size_t size() const
+        {
+            return count;
+        }
+
+        decltype(auto) operator[](size_t n) const
+        {
+            TBoundsPolicy::check_index(n, count);
+            return base[n * step];
+        }
+    };
+
+    template <typename TBoundsPolicy = Unchecked, typename TContainer>
+        requires std::random_access_iterator<ViewIterator_t<TContainer>>
+    auto stride_view(TContainer& container, size_t step)
+    {
+        if (step == 0)
+            throw std::invalid_argument("stride_view - step must be positive");
+
+        const size_t size = std::size(container);
+        const size_t count = size == 0 ? 0 : (size - 1) / step + 1; // size + step - 1 would wrap for a huge step
+        return StrideView<ViewIterator_t<TContainer>, TBoundsPolicy>{view_begin(container), count, step};
+    }
+
+    template <std::random_access_iterator It, typename TBoundsPolicy = Unchecked>
+    class GatherView : public std::ranges::view_interface<GatherView<It, TBoundsPolicy>>
+    {
+        It base{};
+        std::span<const size_t> indices;
+
+    public:
+        class iterator
+        {
+            It base{};
+            const size_t* index{};
+
+        public:
+            using value_type = std::iter_value_t<It>;
+            using difference_type = std::ptrdiff_t;
+
+            iterator() = default;
+
+            iterator(It base, const size_t* index)
+                : base{base}
+                , index{index}
+            { }
+
+            decltype(auto) operator*() const
+            {
+                return base[*index];
+            }
+
+            iterator& operator++()
+            {
+                ++index;
+                return *this;
+            }
+
+            iterator operator++(int)
+            {
+                auto temp = *this;
+                ++index;
+                return temp;
+            }
+
+            bool operator==(const iterator& other) const
+            {
+                return index == other.index;
+            }
+        };
+
+        GatherView() = default;
+
+        GatherView(It base, std::span<const size_t> indices)
+            : base{base}
+            , indices{indices}
+        { }
+
+        iterator begin() const
+        {
+            return {base, indices.data()};
+        }
+
+        iterator end() const
+        {
+            return {base, indices.data() + indices.size()};
+        }
+
+        size_t size() const
+        {
+            return indices.size();
+        }
+
+        decltype(auto) operator[](size_t n) const
+        {
+            TBoundsPolicy::check_index(n, indices.size());
+            return base[indices[n]];
+        }
+    };
+
+    // indices are validated once here - iteration is unchecked
+    template <typename TBoundsPolicy = Unchecked, typename TContainer>
+        requires std::random_access_iterator<ViewIterator_t<TContainer>>
+    auto gather(TContainer& container, std::span<const size_t> indices)
+    {
+        for (size_t index : indices)
+            TBoundsPolicy::check_index(index, std::size(container));
+
+        return GatherView<ViewIterator_t<TContainer>, TBoundsPolicy>{view_begin(container), indices};
+    }
+
+    // the view does not own the indices - a temporary container would dangle
+    template <typename TBoundsPolicy = Unchecked, typename TContainer, typename TIndices>
+        requires (!std::ranges::borrowed_range<TIndices>)
+    auto gather(TContainer& container, TIndices&& indices) = delete;
+
+    static_assert(std::ranges::forward_range<StrideView<int*>> && std::ranges::view<StrideView<int*>>);
+    static_assert(std::ranges::forward_range<GatherView<int*>> && std::ranges::view<GatherView<int*>>);
+
+    template <typename TIndices>
+    concept GatherableBy = requires(std::vector<int>& vec, TIndices&& indices) { gather(vec, std::forward<TIndices>(indices)); };
+
+    static_assert(GatherableBy<std::vector<size_t>&>);
+    static_assert(GatherableBy<const std::vector<size_t>&>);
+    static_assert(GatherableBy<std::span<const size_t>>);
+    static_assert(!GatherableBy<std::vector<size_t>>);
+    static_assert(!GatherableBy<std::array<size_t, 3>>);
+} // namespace Views
+
+TEST_CASE("views - get_nth family")
+{
+    std::vector<int> vec = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+    SECTION("get_nth with bounds policy")
+    {
+        Views::get_nth(vec, 3) = 33;
+        REQUIRE(vec[3] == 33);
+        REQUIRE_THROWS_AS(Views::get_nth<Views::Checked>(vec, 10), std::out_of_range);
+    }
+
+    SECTION("slice of contiguous container is a span")
+    {
+        auto s = Views::slice(vec, 2, 3);
+        static_assert(is_same_v<decltype(s), std::span<int>>);
+        REQUIRE(std::ranges::equal(s, std::vector{2, 3, 4}));
+
+        s[0] = -2;
+        REQUIRE(vec[2] == -2);
+
+        const std::vector<int>& cvec = vec;
+        static_assert(is_same_v<decltype(Views::slice(cvec, 0, 1)), std::span<const int>>);
+
+        REQUIRE_THROWS_AS(Views::slice<Views::Checked>(vec, 8, 3), std::out_of_range);
+        REQUIRE_NOTHROW(Views::slice<Views::Checked>(vec, 10, 0));
+    }
+
+    SECTION("slice of vector<bool> stays packed")
+    {
+        std::vector<bool> flags = {true, false, true, false, true};
+
+        auto s = Views::slice(flags, 1, 3);
+        REQUIRE(std::ranges::equal(s, std::vector<bool>{false, true, false}));
+
+        s[1] = false; // std::vector<bool>::reference proxy
+        REQUIRE(flags[2] == false);
+    }
+
+    SECTION("stride_view")
+    {
+        auto every_3rd = Views::stride_view(vec, 3);
+        REQUIRE(every_3rd.size() == 4);
+        REQUIRE(std::ranges::equal(every_3rd, std::vector{0, 3, 6, 9}));
+
+        for (int& item : every_3rd)
+            item *= 10;
+        REQUIRE(vec == std::vector{0, 1, 2, 30, 4, 5, 60, 7, 8, 90});
+
+        REQUIRE_THROWS_AS(Views::stride_view<Views::Checked>(vec, 3)[4], std::out_of_range);
+
+        std::vector<bool> flags = {true, false, true, false, true};
+        REQUIRE(std::ranges::all_of(Views::stride_view(flags, 2), [](bool flag) { return flag; }));
+
+        auto first_only = Views::stride_view(vec, std::numeric_limits<size_t>::max());
+        REQUIRE(first_only.size() == 1);
+        REQUIRE(first_only[0] == 0);
+
+        std::vector<int> empty;
+        REQUIRE(Views::stride_view(empty, 3).size() == 0);
+
+        REQUIRE_THROWS_AS(Views::stride_view(vec, 0), std::invalid_argument);
+    }
+
+    SECTION("gather")
+    {
+        const std::vector<size_t> indices = {9, 0, 5, 5};
+        auto gathered = Views::gather(vec, indices);
+        REQUIRE(std::ranges::equal(gathered, std::vector{9, 0, 5, 5}));
+
+        gathered[1] = 100;
+        REQUIRE(vec[0] == 100);
+
+        const std::vector<size_t> evil_indices = {1, 10};
+        REQUIRE_THROWS_AS(Views::gather<Views::Checked>(vec, evil_indices), std::out_of_range);
+    }
+}
+
+TEST_CASE("views - get_nth family - benchmarks", "[.][benchmark]")
+{
+    std::vector<int> data(1'000'000);
+    std::iota(data.begin(), data.end(), 0);
+
+    std::vector<size_t> indices(64 * 1024);
+    std::ranges::generate(indices, [gen = std::mt19937{665}, &data] mutable { return gen() % data.size(); });
+
+    BENCHMARK("slice - view")
+    {
+        auto s = Views::slice(data, 1000, 500'000);
+        return std::accumulate(s.begin(), s.end(), 0LL);
+    };
+
+    BENCHMARK("slice - copy of sub-vector")
+    {
+        std::vector<int> s(data.begin() + 1000, data.begin() + 501'000);
+        return std::accumulate(s.begin(), s.end(), 0LL);
+    };
+
+    BENCHMARK("stride_view(4) - view")
+    {
+        auto s = Views::stride_view(data, 4);
+        return std::accumulate(s.begin(), s.end(), 0LL);
+    };
+
+    BENCHMARK("stride_view(4) - copy to vector")
+    {
+        std::vector<int> s;
+        s.reserve(data.size() / 4);
+        for (size_t i = 0; i < data.size(); i += 4)
+            s.push_back(data[i]);
+        return std::accumulate(s.begin(), s.end(), 0LL);
+    };
+
+    BENCHMARK("gather - view")
+    {
+        auto g = Views::gather(data, indices);
+        return std::accumulate(g.begin(), g.end(), 0LL);
+    };
+
+    BENCHMARK("gather - copy to vector")
+    {
+        std::vector<int> g;
+        g.reserve(indices.size());
+        for (size_t index : indices)
+            g.push_back(data[index]);
+        return std::accumulate(g.begin(), g.end(), 0LL);
+    };
+
+    std::vector<bool> flags(1'000'000);
+    for (size_t i = 0; i < flags.size(); i += 3)
+        flags[i] = true;
+
+    BENCHMARK("vector<bool> slice - packed view")
+    {
+        return std::ranges::count(Views::slice(flags, 1000, 500'000), true);
+    };
+
+    BENCHMARK("vector<bool> slice - copy of sub-vector")
+    {
+        std::vector<bool> s(flags.begin() + 1000, flags.begin() + 501'000);
+        return std::ranges::count(s, true);
+    };
+}
@@ -0,0 +1,36 @@
+// Compile-time stress test for type_list.hpp - only the build time matters,
+// the list length is set with -DTYPE_LIST_SIZE=<n>
+
+#include "type_list.hpp"
+
+#include <type_traits>
+#include <utility>
+
+#ifndef TYPE_LIST_SIZE
+#define TYPE_LIST_SIZE 1000
+#endif
+
+namespace
+{
+    constexpr size_t size = TYPE_LIST_SIZE;
+    constexpr size_t distinct = 64;
+
+    template <size_t N>
+    using Item = std::integral_constant<size_t, N % distinct>;
+
+    template <typename T>
+    struct IsEven : std::bool_constant<T::value % 2 == 0>
+    { };
+
+    using List = decltype([]<size_t... Is>(std::index_sequence<Is...>) {
+        return tl::type_list<Item<Is>...>{};
+    }(std::make_index_sequence<size>{}));
+
+    static_assert(List::size == size);
+    static_assert(std::is_same_v<tl::at_t<List, size - 1>, Item<size - 1>>);
+    static_assert(tl::index_of_v<List, Item<distinct - 1>> == distinct - 1);
+    static_assert(!tl::contains_v<List, void>);
+    static_assert(tl::transform_t<List, std::add_pointer_t>::size == size);
+    static_assert(tl::filter_t<List, IsEven>::size == size / 2);
+    static_assert(tl::unique_t<List>::size == distinct);
+} // namespace
@@ -0,0 +1,213 @@
+#ifndef TYPE_LIST_HPP
+#define TYPE_LIST_HPP
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+// nested - without __has_builtin (MSVC, GCC < 10) the operand of && would not be parsed as a call
+#ifdef __has_builtin
+#if __has_builtin(__type_pack_element)
+#define TYPE_LIST_HAS_TYPE_PACK_ELEMENT 1
+#endif
+#endif
+
+// Type lists without recursive instantiation - every operation expands the pack once,
+// so the instantiation depth does not grow with the length of the list.
+namespace tl
+{
+    template <typename... Ts>
+    struct type_list
+    {
+        static constexpr size_t size = sizeof...(Ts);
+    };
+
+    namespace details
+    {
+#ifdef TYPE_LIST_HAS_TYPE_PACK_ELEMENT
+        template <size_t I, typename... Ts>
+        using pack_element = __type_pack_element<I, Ts...>;
+#else
+        // all items are bases of one class - overload resolution picks the base with index I
+        template <size_t I, typename T>
+        struct indexed
+        {
+            using type = T;
+        };
+
+        template <typename TIndices, typename... Ts>
+        struct indexer;
+
+        template <size_t... Is, typename... Ts>
+        struct indexer<std::index_sequence<Is...>, Ts...> : indexed<Is, Ts>...
+        { };
+
+        template <size_t I, typename T>
+        indexed<I, T> select(const indexed<I, T>&);
+
+        template <size_t I, typename... Ts>
+        using pack_element = typename decltype(select<I>(indexer<std::index_sequence_for<Ts...>, Ts...>{}))::type;
+#endif
+
+        // distinct address for every type - types can be compared in constexpr loops
+        template <typename T>
+        inline constexpr char type_tag{};
+
+        template <typename T>
+        constexpr const void* type_id = &type_tag<T>;
+    } // namespace details
+
+    //////////////////////////////////////
+    // at
+
+    template <typename TList, size_t I>
+    struct at;
+
+    template <typename... Ts, size_t I>
+    struct at<type_list<Ts...>, I>
+    {
+        static_assert(I < sizeof...(Ts), "index out of range");
+        using type = details::pack_element<I, Ts...>;
+    };
+
+    template <typename TList, size_t I>
+    using at_t = typename at<TList, I>::type;
+
+    //////////////////////////////////////
+    // index_of - size of the list when T is missing
+
+    template <typename TList, typename T>
+    struct index_of;
+
+    template <typename... Ts, typename T>
+    struct index_of<type_list<Ts...>, T>
+    {
+        static constexpr size_t value = [] {
+            constexpr bool matches[] = {std::is_same_v<T, Ts>..., false};
+            size_t index = 0;
+            while (index < sizeof...(Ts) && !matches[index])
+                ++index;
+            return index;
+        }();
+    };
+
+    template <typename TList, typename T>
+    inline constexpr size_t index_of_v = index_of<TList, T>::value;
+
+    //////////////////////////////////////
+    // contains
+
+    template <typename TList, typename T>
+    inline constexpr bool contains_v = index_of_v<TList, T> < TList::size;
+
+    //////////////////////////////////////
+    // transform
+
+    template <typename TList, template <typename> class F>
+    struct transform;
+
+    template <typename... Ts, template <typename> class F>
+    struct transform<type_list<Ts...>, F>
+    {
+        using type = type_list<F<Ts>...>;
+    };
+
+    template <typename TList, template <typename> class F>
+    using transform_t = typename transform<TList, F>::type;
+
+    //////////////////////////////////////
+    // select - items at the given indices
+
+    template <typename TList, auto Indices, typename = std::make_index_sequence<Indices.size()>>
+    struct select;
+
+    template <typename... Ts, auto Indices, size_t... Is>
+    struct select<type_list<Ts...>, Indices, std::index_sequence<Is...>>
+    {
+        using type = type_list<details::pack_element<Indices[Is], Ts...>...>;
+    };
+
+    template <typename TList, auto Indices>
+    using select_t = typename select<TList, Indices>::type;
+
+    namespace details
+    {
+        template <size_t Count, size_t N>
+        constexpr auto indices_of(const std::array<bool, N>& mask)
+        {
+            std::array<size_t, Count> indices{};
+            for (size_t i = 0, j = 0; i < N; ++i)
+                if (mask[i])
+                    indices[j++] = i;
+            return indices;
+        }
+
+        template <size_t N>
+        constexpr size_t count(const std::array<bool, N>& mask)
+        {
+            size_t result = 0;
+            for (bool flag : mask)
+                result += flag;
+            return result;
+        }
+    } // namespace details
+
+    //////////////////////////////////////
+    // filter - items for which Predicate<T>::value is true
+
+    template <typename TList, template <typename> class Predicate>
+    struct filter;
+
+    template <typename... Ts, template <typename> class Predicate>
+    struct filter<type_list<Ts...>, Predicate>
+    {
+        static constexpr std::array<bool, sizeof...(Ts)> mask = {Predicate<Ts>::value...};
+        static constexpr auto indices = details::indices_of<details::count(mask)>(mask);
+
+        using type = select_t<type_list<Ts...>, indices>;
+    };
+
+    template <typename TList, template <typename> class Predicate>
+    using filter_t = typename filter<TList, Predicate>::type;
+
+    //////////////////////////////////////
+    // unique - first occurrence of every type, O(size * unique count) constexpr steps
+
+    template <typename TList>
+    struct unique;
+
+    template <typename... Ts>
+    struct unique<type_list<Ts...>>
+    {
+        static constexpr std::array<bool, sizeof...(Ts)> mask = [] {
+            constexpr std::array<const void*, sizeof...(Ts)> ids = {details::type_id<Ts>...};
+            std::array<const void*, sizeof...(Ts)> seen{};
+            std::array<bool, sizeof...(Ts)> first{};
+            size_t seen_count = 0;
+
+            for (size_t i = 0; i < ids.size(); ++i)
+            {
+                bool found = false;
+                for (size_t j = 0; j < seen_count && !found; ++j)
+                    found = seen[j] == ids[i];
+
+                if (!found)
+                {
+                    seen[seen_count++] = ids[i];
+                    first[i] = true;
+                }
+            }
+            return first;
+        }();
+
+        static constexpr auto indices = details::indices_of<details::count(mask)>(mask);
+
+        using type = select_t<type_list<Ts...>, indices>;
+    };
+
+    template <typename TList>
+    using unique_t = typename unique<TList>::type;
+} // namespace tl
+
+#endif
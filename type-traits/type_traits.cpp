@@ -1,3 +1,5 @@
+#include "type_list.hpp"
+
 #include <catch2/catch_test_macros.hpp>
 #include <iostream>
 #include <string>
@@ -175,4 +177,32 @@ TEST_CASE("never void")
 
     //never_pointer(&x);
     never_pointer(x);
-}
\ No newline at end of file
+}
+
+/////////////////////////
+// Type lists
+
+TEST_CASE("type lists")
+{
+    using List = tl::type_list<int, int*, const char*, double, int*, std::string&, void>;
+
+    static_assert(List::size == 7);
+    static_assert(IsSame_v<tl::at_t<List, 0>, int>);
+    static_assert(IsSame_v<tl::at_t<List, 6>, void>);
+
+    static_assert(tl::index_of_v<List, int*> == 1);
+    static_assert(tl::index_of_v<List, float> == List::size);
+    static_assert(tl::contains_v<List, std::string&>);
+    static_assert(!tl::contains_v<List, std::string>);
+
+    static_assert(IsSame_v<tl::transform_t<List, RemoveReference_t>,
+        tl::type_list<int, int*, const char*, double, int*, std::string, void>>);
+
+    static_assert(IsSame_v<tl::filter_t<List, IsPointer>, tl::type_list<int*, const char*, int*>>);
+    static_assert(IsSame_v<tl::filter_t<List, IsVoid>, tl::type_list<void>>);
+    static_assert(IsSame_v<tl::filter_t<tl::type_list<>, IsVoid>, tl::type_list<>>);
+
+    static_assert(IsSame_v<tl::unique_t<tl::transform_t<List, RemoveReference_t>>,
+        tl::type_list<int, int*, const char*, double, std::string, void>>);
+    static_assert(IsSame_v<tl::unique_t<tl::type_list<>>, tl::type_list<>>);
+}
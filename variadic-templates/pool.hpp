@@ -0,0 +1,264 @@
+#ifndef POOL_HPP
+#define POOL_HPP
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+#if defined(__SANITIZE_ADDRESS__)
+#define POOL_HAS_ASAN 1
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define POOL_HAS_ASAN 1
+#endif
+#endif
+
+#ifdef POOL_HAS_ASAN
+#include <sanitizer/asan_interface.h>
+#define POOL_POISON(ptr, size) ASAN_POISON_MEMORY_REGION(ptr, size)
+#define POOL_UNPOISON(ptr, size) ASAN_UNPOISON_MEMORY_REGION(ptr, size)
+#else
+#define POOL_POISON(ptr, size) ((void)(ptr), (void)(size))
+#define POOL_UNPOISON(ptr, size) ((void)(ptr), (void)(size))
+#endif
+
+// Object pool - a drop-in for make_unique<T>(args...) when small objects are created & destroyed at high rates.
+//
+//   auto gadget = Pooling::pool<Gadget>::make(42, "ipad"); // std::unique_ptr<Gadget, pool<Gadget>::Deleter>
+//
+// Released storage goes to a free list of the releasing thread; full batches of BatchSize nodes
+// are handed over to a global list (one lock per batch, not per object). Storage is never returned
+// to the system before the static destruction - pooled objects must not outlive it.
+// Objects sitting in a free list are poisoned when built with AddressSanitizer (-DENABLE_ASAN=ON).
+
+namespace Pooling
+{
+    // released objects are destroyed, reuse constructs a new object in the recycled storage
+    struct DestroyOnRelease
+    {
+        static constexpr bool keeps_objects = false;
+    };
+
+    // released objects stay alive in the free list, reuse reinitializes them - obj.assign(args...)
+    // when T provides it, move assignment from T(args...) otherwise - so e.g. std::string members
+    // keep their capacity
+    struct ReinitializeOnReuse
+    {
+        static constexpr bool keeps_objects = true;
+
+        template <typename T, typename... TArgs>
+        static void reinitialize(T& obj, TArgs&&... args)
+        {
+            if constexpr (requires { obj.assign(std::forward<TArgs>(args)...); })
+                obj.assign(std::forward<TArgs>(args)...);
+            else
+                obj = T(std::forward<TArgs>(args)...);
+        }
+    };
+
+    template <typename T, typename TPolicy = DestroyOnRelease, size_t BatchSize = 64>
+    class pool
+    {
+        static_assert(BatchSize > 0);
+
+        struct Node
+        {
+            alignas(T) std::byte storage[sizeof(T)];
+            Node* next = nullptr;
+            bool alive = false;
+
+            T* object() noexcept
+            {
+                return std::launder(reinterpret_cast<T*>(storage));
+            }
+
+            static Node* of(T* ptr) noexcept
+            {
+                return reinterpret_cast<Node*>(reinterpret_cast<std::byte*>(ptr)); // storage is the first member
+            }
+        };
+
+        struct Batch
+        {
+            Node* head = nullptr;
+            size_t count = 0;
+        };
+
+        class SharedList
+        {
+            std::mutex mutex;
+            std::vector<Batch> batches;
+            std::vector<std::unique_ptr<Node[]>> chunks;
+
+        public:
+            SharedList() = default;
+            SharedList(const SharedList&) = delete;
+            SharedList& operator=(const SharedList&) = delete;
+
+            ~SharedList()
+            {
+                for (const Batch& batch : batches)
+                {
+                    for (Node* node = batch.head; node != nullptr; node = node->next)
+                    {
+                        POOL_UNPOISON(node->storage, sizeof(T));
+                        if (node->alive)
+                            std::destroy_at(node->object());
+                    }
+                }
+            }
+
+            void push(Batch batch)
+            {
+                std::lock_guard lock{mutex};
+                batches.push_back(batch);
+            }
+
+            Batch pop()
+            {
+                std::lock_guard lock{mutex};
+
+                if (!batches.empty())
+                {
+                    const Batch batch = batches.back();
+                    batches.pop_back();
+                    return batch;
+                }
+
+                Node* chunk = chunks.emplace_back(std::make_unique_for_overwrite<Node[]>(BatchSize)).get();
+                for (size_t i = 0; i < BatchSize; ++i)
+                {
+                    chunk[i].next = i + 1 < BatchSize ? &chunk[i + 1] : nullptr;
+                    POOL_POISON(chunk[i].storage, sizeof(T));
+                }
+                return Batch{chunk, BatchSize};
+            }
+        };
+
+        // free list of a thread - handed over to the shared list when the thread exits
+        struct LocalList : Batch
+        {
+            constexpr LocalList() = default;
+
+            ~LocalList()
+            {
+                if (this->head != nullptr)
+                    shared().push(*this);
+            }
+        };
+
+        static SharedList& shared()
+        {
+            static SharedList list;
+            return list;
+        }
+
+        static inline constinit thread_local LocalList local{};
+
+        static Node* acquire()
+        {
+            LocalList& list = local;
+            if (list.head == nullptr)
+                static_cast<Batch&>(list) = shared().pop();
+
+            Node* node = list.head;
+            list.head = node->next;
+            --list.count;
+            return node;
+        }
+
+        static void recycle(Node* node) noexcept
+        {
+            POOL_POISON(node->storage, sizeof(T));
+
+            LocalList& list = local;
+            node->next = list.head;
+            list.head = node;
+
+            if (++list.count < 2 * BatchSize)
+                return;
+
+            // hand the most recently released half over, keep the rest warm
+            Node* last = list.head;
+            for (size_t i = 1; i < BatchSize; ++i)
+                last = last->next;
+
+            Batch batch{list.head, BatchSize};
+            list.head = last->next;
+            list.count -= BatchSize;
+            last->next = nullptr;
+
+            try
+            {
+                shared().push(batch);
+            }
+            catch (...)
+            {
+                last->next = list.head; // out of memory for the shared list - keep the batch
+                list.head = batch.head;
+                list.count += BatchSize;
+            }
+        }
+
+    public:
+        struct Deleter
+        {
+            void operator()(T* ptr) const noexcept
+            {
+                pool::release(ptr);
+            }
+        };
+
+        using unique_ptr = std::unique_ptr<T, Deleter>;
+
+        template <typename... TArgs>
+        static unique_ptr make(TArgs&&... args)
+        {
+            Node* node = acquire();
+            POOL_UNPOISON(node->storage, sizeof(T));
+
+            try
+            {
+                if constexpr (TPolicy::keeps_objects)
+                {
+                    if (node->alive)
+                    {
+                        TPolicy::reinitialize(*node->object(), std::forward<TArgs>(args)...);
+                        return unique_ptr{node->object()};
+                    }
+                }
+
+                std::construct_at(reinterpret_cast<T*>(node->storage), std::forward<TArgs>(args)...);
+                node->alive = true;
+            }
+            catch (...)
+            {
+                recycle(node);
+                throw;
+            }
+
+            return unique_ptr{node->object()};
+        }
+
+        static void release(T* ptr) noexcept
+        {
+            if (ptr == nullptr)
+                return;
+
+            Node* node = Node::of(ptr);
+
+            if constexpr (!TPolicy::keeps_objects)
+            {
+                std::destroy_at(ptr);
+                node->alive = false;
+            }
+
+            recycle(node);
+        }
+    };
+} // namespace Pooling
+
+#endif
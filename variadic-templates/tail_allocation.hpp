@@ -0,0 +1,162 @@
+#ifndef TAIL_ALLOCATION_HPP
+#define TAIL_ALLOCATION_HPP
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <new>
+#include <span>
+#include <utility>
+
+// Header object followed by n trailing elements in a single allocation.
+//
+//   auto msg = TailAllocation::make_unique_with_tail<MessageHeader, std::byte>(length, type, length);
+//   std::span<std::byte> payload = TailAllocation::tail(msg);
+//
+// Layout: [T][padding to alignof(TElem)][TElem x n] - the block is aligned for both types.
+// The header is constructed first, then the elements in order; destruction runs in reverse.
+
+namespace TailAllocation
+{
+    template <typename T, typename TElem>
+    struct Layout
+    {
+        static constexpr size_t alignment = std::max(alignof(T), alignof(TElem));
+        static constexpr size_t tail_offset = (sizeof(T) + alignof(TElem) - 1) / alignof(TElem) * alignof(TElem);
+
+        static constexpr size_t size(size_t count)
+        {
+            if (count > (std::numeric_limits<size_t>::max() - tail_offset) / sizeof(TElem))
+                throw std::bad_array_new_length{};
+            return tail_offset + count * sizeof(TElem);
+        }
+
+        static void* allocate(size_t count)
+        {
+            if constexpr (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+                return ::operator new(size(count), std::align_val_t{alignment});
+            else
+                return ::operator new(size(count));
+        }
+
+        static void deallocate(void* block, size_t count) noexcept
+        {
+            if constexpr (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+                ::operator delete(block, size(count), std::align_val_t{alignment});
+            else
+                ::operator delete(block, size(count));
+        }
+
+        static TElem* tail(void* block) noexcept
+        {
+            return reinterpret_cast<TElem*>(static_cast<std::byte*>(block) + tail_offset);
+        }
+    };
+
+    template <typename T, typename TElem>
+    class TailDeleter
+    {
+        size_t count = 0;
+
+    public:
+        TailDeleter() = default;
+
+        explicit TailDeleter(size_t count) noexcept
+            : count{count}
+        { }
+
+        size_t size() const noexcept
+        {
+            return count;
+        }
+
+        void operator()(T* header) const noexcept
+        {
+            using L = Layout<T, TElem>;
+
+            if (count > 0) // no TElem object to launder in an empty tail
+            {
+                TElem* elements = std::launder(L::tail(header));
+                for (size_t i = count; i > 0; --i)
+                    std::destroy_at(elements + i - 1);
+            }
+
+            std::destroy_at(header);
+            L::deallocate(header, count);
+        }
+    };
+
+    template <typename T, typename TElem>
+    using unique_ptr_with_tail = std::unique_ptr<T, TailDeleter<T, TElem>>;
+
+    namespace Details
+    {
+        template <bool ValueInitialize, typename T, typename TElem, typename... TArgs>
+        unique_ptr_with_tail<T, TElem> make_with_tail(size_t count, TArgs&&... args)
+        {
+            using L = Layout<T, TElem>;
+
+            void* block = L::allocate(count);
+            T* header = nullptr;
+            size_t constructed = 0;
+
+            try
+            {
+                header = ::new (block) T(std::forward<TArgs>(args)...);
+
+                for (TElem* element = L::tail(block); constructed < count; ++constructed, ++element)
+                {
+                    if constexpr (ValueInitialize)
+                        ::new (static_cast<void*>(element)) TElem();
+                    else
+                        ::new (static_cast<void*>(element)) TElem;
+                }
+            }
+            catch (...)
+            {
+                if (header)
+                {
+                    if (constructed > 0)
+                    {
+                        TElem* elements = std::launder(L::tail(block));
+                        while (constructed > 0)
+                            std::destroy_at(elements + --constructed);
+                    }
+                    std::destroy_at(header);
+                }
+                L::deallocate(block, count);
+                throw;
+            }
+
+            return unique_ptr_with_tail<T, TElem>{header, TailDeleter<T, TElem>{count}};
+        }
+    } // namespace Details
+
+    // header constructed from args, count value-initialized elements
+    template <typename T, typename TElem, typename... TArgs>
+        requires std::constructible_from<T, TArgs...> && std::default_initializable<TElem>
+    unique_ptr_with_tail<T, TElem> make_unique_with_tail(size_t count, TArgs&&... args)
+    {
+        return Details::make_with_tail<true, T, TElem>(count, std::forward<TArgs>(args)...);
+    }
+
+    // as above, but the elements are default-initialized - no zeroing of trivial types
+    template <typename T, typename TElem, typename... TArgs>
+        requires std::constructible_from<T, TArgs...> && std::default_initializable<TElem>
+    unique_ptr_with_tail<T, TElem> make_unique_with_tail_for_overwrite(size_t count, TArgs&&... args)
+    {
+        return Details::make_with_tail<false, T, TElem>(count, std::forward<TArgs>(args)...);
+    }
+
+    template <typename T, typename TElem>
+    std::span<TElem> tail(const unique_ptr_with_tail<T, TElem>& ptr) noexcept
+    {
+        if (!ptr || ptr.get_deleter().size() == 0)
+            return {};
+        return {std::launder(Layout<T, TElem>::tail(ptr.get())), ptr.get_deleter().size()};
+    }
+} // namespace TailAllocation
+
+#endif
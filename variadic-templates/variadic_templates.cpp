@@ -1,6 +1,27 @@
+#include "instrumentation.hpp"
+#include "pool.hpp"
+#include "tail_allocation.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <charconv>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
 #include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
 #include <vector>
 
 using namespace std::literals;
@@ -8,11 +29,34 @@ using namespace std::literals;
 namespace ExplainStd
 {
     template <typename T, typename... TArg>
+        requires(!std::is_array_v<T>)
     std::unique_ptr<T> make_unique(TArg&&... arg)
     {
         return std::unique_ptr<T>(new T(std::forward<TArg>(arg)...));
     }
 
+    template <typename T>
+        requires std::is_unbounded_array_v<T>
+    std::unique_ptr<T> make_unique(size_t size)
+    {
+        return std::unique_ptr<T>(new std::remove_extent_t<T>[size]()); // value-initialized
+    }
+
+    // default-initialization - trivial types are left uninitialized
+    template <typename T>
+        requires(!std::is_array_v<T>)
+    std::unique_ptr<T> make_unique_for_overwrite()
+    {
+        return std::unique_ptr<T>(new T);
+    }
+
+    template <typename T>
+        requires std::is_unbounded_array_v<T>
+    std::unique_ptr<T> make_unique_for_overwrite(size_t size)
+    {
+        return std::unique_ptr<T>(new std::remove_extent_t<T>[size]);
+    }
+
     // template <typename T, typename TArg1, typename TArg2>
     // std::unique_ptr<T> make_unique(TArg1&& arg1, TArg2&& arg2)
     // {
@@ -34,6 +78,13 @@ struct Gadget
         : id{id}
         , name{std::move(name)}
     { }
+
+    // reinitialization of a recycled object (Pooling::ReinitializeOnReuse) - name keeps its capacity
+    void assign(int new_id, std::string_view new_name = "noname")
+    {
+        id = new_id;
+        name = new_name;
+    }
 };
 
 TEST_CASE("variadic templates - make_unique")
@@ -42,6 +93,431 @@ TEST_CASE("variadic templates - make_unique")
     auto ptr_g2 = ExplainStd::make_unique<Gadget>(42, "ipad");
 }
 
+TEST_CASE("variadic templates - make_unique - copies, moves & allocations")
+{
+    using Instrumentation::Event;
+
+    SECTION("arguments are forwarded to the constructor")
+    {
+        Instrumentation::Scope scope;
+        auto ptr = ExplainStd::make_unique<Probe<Gadget>>(42, "ipad");
+
+        const auto counts = scope.counts();
+        REQUIRE(counts[Event::constructed] == 1);
+        REQUIRE(counts.copies() == 0);
+        REQUIRE(counts.moves() == 0);
+        REQUIRE(counts.allocations() == 1);
+        REQUIRE(counts.allocated_bytes() == sizeof(Probe<Gadget>));
+    }
+
+    SECTION("rvalue string is moved - no extra allocation")
+    {
+        std::string name(64, 'x');
+
+        Instrumentation::Scope scope;
+        auto ptr = ExplainStd::make_unique<Probe<Gadget>>(42, std::move(name));
+
+        REQUIRE(scope.counts().allocations() == 1);
+    }
+
+    SECTION("unique_ptr owns the only instance")
+    {
+        Instrumentation::Scope scope;
+        {
+            auto ptr = ExplainStd::make_unique<Probe<Gadget>>(42);
+            auto other = std::move(ptr);
+        }
+
+        REQUIRE(scope.counts().constructions() == 1);
+        REQUIRE(scope.counts().destructions() == 1);
+        REQUIRE(scope.counts().deallocations() == 1);
+    }
+}
+
+TEST_CASE("variadic templates - make_unique - benchmarks", "[.][benchmark]")
+{
+    const std::string name = "ipad";
+
+    BENCHMARK("ExplainStd::make_unique<Gadget>(int, const char*)")
+    {
+        return ExplainStd::make_unique<Gadget>(42, "ipad");
+    };
+
+    BENCHMARK("std::make_unique<Gadget>(int, const char*)")
+    {
+        return std::make_unique<Gadget>(42, "ipad");
+    };
+
+    BENCHMARK("ExplainStd::make_unique<Gadget>(int, const std::string&)")
+    {
+        return ExplainStd::make_unique<Gadget>(42, name);
+    };
+
+    BENCHMARK("std::unique_ptr<Gadget>(new Gadget(int, const std::string&))")
+    {
+        return std::unique_ptr<Gadget>(new Gadget(42, name));
+    };
+}
+
+TEST_CASE("variadic templates - pool")
+{
+    using Instrumentation::Event;
+
+    SECTION("objects are constructed in place & destroyed on release")
+    {
+        Instrumentation::Scope scope;
+        {
+            auto ptr = Pooling::pool<Probe<Gadget>>::make(42, "ipad");
+            REQUIRE(ptr->id == 42);
+            REQUIRE(ptr->name == "ipad");
+        }
+
+        const auto counts = scope.counts();
+        REQUIRE(counts[Event::constructed] == 1);
+        REQUIRE(counts.copies() == 0);
+        REQUIRE(counts.moves() == 0);
+        REQUIRE(counts.destructions() == 1);
+    }
+
+    SECTION("released storage is reused - no allocation")
+    {
+        const Probe<Gadget>* released = Pooling::pool<Probe<Gadget>>::make(1).get();
+
+        Instrumentation::Scope scope;
+        auto ptr = Pooling::pool<Probe<Gadget>>::make(2);
+
+        REQUIRE(ptr.get() == released);
+        REQUIRE(ptr->name == "noname");
+        REQUIRE(scope.counts().allocations() == 0);
+    }
+
+    SECTION("ReinitializeOnReuse - recycled objects keep their string capacity")
+    {
+        using GadgetPool = Pooling::pool<Probe<Gadget>, Pooling::ReinitializeOnReuse>;
+        const std::string name(64, 'x');
+        GadgetPool::make(1, name);
+
+        Instrumentation::Scope scope;
+        auto ptr = GadgetPool::make(2, name);
+
+        REQUIRE(ptr->id == 2);
+        REQUIRE(ptr->name == name);
+        REQUIRE(scope.counts().constructions() == 0);
+        REQUIRE(scope.counts().destructions() == 0);
+        REQUIRE(scope.counts().allocations() == 0);
+    }
+
+    SECTION("a constructor that throws leaves the pool intact")
+    {
+        struct Fragile
+        {
+            explicit Fragile(bool fail)
+            {
+                if (fail)
+                    throw std::runtime_error{"fail"};
+            }
+        };
+
+        REQUIRE_THROWS_AS(Pooling::pool<Fragile>::make(true), std::runtime_error);
+        REQUIRE(Pooling::pool<Fragile>::make(false) != nullptr);
+    }
+
+    SECTION("objects released by another thread return to the pool in batches")
+    {
+        using GadgetPool = Pooling::pool<Probe<Gadget>, Pooling::DestroyOnRelease, 8>;
+        constexpr int count = 1000;
+
+        std::vector<GadgetPool::unique_ptr> gadgets;
+        gadgets.reserve(count);
+
+        const auto start = Instrumentation::all_threads();
+
+        for (int i = 0; i < count; ++i)
+            gadgets.push_back(GadgetPool::make(i, "gadget"));
+
+        std::thread consumer{[&gadgets] { gadgets.clear(); }};
+        consumer.join();
+
+        const auto after_release = Instrumentation::all_threads();
+        REQUIRE((after_release - start).constructions() == count);
+        REQUIRE((after_release - start).destructions() == count);
+
+        for (int i = 0; i < count; ++i)
+            gadgets.push_back(GadgetPool::make(i, "gadget"));
+
+        REQUIRE((Instrumentation::all_threads() - after_release).allocations() == 0);
+    }
+}
+
+TEST_CASE("variadic templates - pool - benchmarks", "[.][benchmark]")
+{
+    const std::string short_name = "ipad";
+    const std::string long_name(32, 'x'); // beyond the small string buffer
+
+    BENCHMARK("std::make_unique<Gadget>(int, short name)")
+    {
+        return std::make_unique<Gadget>(42, short_name);
+    };
+
+    BENCHMARK("pool<Gadget>::make(int, short name)")
+    {
+        return Pooling::pool<Gadget>::make(42, short_name);
+    };
+
+    BENCHMARK("std::make_unique<Gadget>(int, long name)")
+    {
+        return std::make_unique<Gadget>(42, long_name);
+    };
+
+    BENCHMARK("pool<Gadget>::make(int, long name)")
+    {
+        return Pooling::pool<Gadget>::make(42, long_name);
+    };
+
+    BENCHMARK("pool<Gadget, ReinitializeOnReuse>::make(int, long name)")
+    {
+        return Pooling::pool<Gadget, Pooling::ReinitializeOnReuse>::make(42, long_name);
+    };
+
+    std::vector<std::unique_ptr<Gadget>> gadgets;
+    gadgets.reserve(1000);
+
+    BENCHMARK("1000 x std::make_unique<Gadget> - create all, then release")
+    {
+        for (int i = 0; i < 1000; ++i)
+            gadgets.push_back(std::make_unique<Gadget>(i, long_name));
+        gadgets.clear();
+    };
+
+    std::vector<Pooling::pool<Gadget>::unique_ptr> pooled_gadgets;
+    pooled_gadgets.reserve(1000);
+
+    BENCHMARK("1000 x pool<Gadget>::make - create all, then release")
+    {
+        for (int i = 0; i < 1000; ++i)
+            pooled_gadgets.push_back(Pooling::pool<Gadget>::make(i, long_name));
+        pooled_gadgets.clear();
+    };
+}
+
+TEST_CASE("variadic templates - make_unique for arrays & make_unique_for_overwrite")
+{
+    auto numbers = ExplainStd::make_unique<int[]>(4);
+    REQUIRE(std::all_of(numbers.get(), numbers.get() + 4, [](int n) { return n == 0; }));
+
+    auto buffer = ExplainStd::make_unique_for_overwrite<char[]>(1024);
+    std::fill_n(buffer.get(), 1024, 'x');
+    REQUIRE(buffer[1023] == 'x');
+
+    auto text = ExplainStd::make_unique_for_overwrite<std::string>(); // class types are still default constructed
+    REQUIRE(text->empty());
+}
+
+namespace
+{
+    struct MessageHeader
+    {
+        uint32_t type;
+        uint32_t length;
+    };
+
+    // header & payload in separate allocations
+    struct Message
+    {
+        uint32_t type;
+        std::vector<std::byte> payload;
+    };
+
+    struct alignas(64) CacheLine
+    {
+        std::byte bytes[64];
+    };
+
+    struct alignas(32) WideHeader
+    {
+        double value;
+    };
+
+    std::vector<int> destruction_log;
+
+    struct Numbered
+    {
+        static inline int next_id = 0;
+        static inline int throw_at = -1;
+
+        int id = next_id++;
+
+        Numbered()
+        {
+            if (id == throw_at)
+                throw std::runtime_error{"Numbered"};
+        }
+
+        explicit Numbered(int id)
+            : id{id}
+        { }
+
+        Numbered(const Numbered&) = delete;
+        Numbered& operator=(const Numbered&) = delete;
+
+        ~Numbered()
+        {
+            destruction_log.push_back(id);
+        }
+    };
+} // namespace
+
+TEST_CASE("variadic templates - make_unique_with_tail")
+{
+    SECTION("header & payload in one allocation")
+    {
+        Instrumentation::Scope scope;
+        {
+            auto message = TailAllocation::make_unique_with_tail<MessageHeader, std::byte>(100, 7u, 100u);
+
+            REQUIRE(message->type == 7);
+            REQUIRE(message->length == 100);
+
+            const auto payload = TailAllocation::tail(message);
+            REQUIRE(payload.size() == 100);
+            REQUIRE(reinterpret_cast<const std::byte*>(payload.data()) == reinterpret_cast<const std::byte*>(message.get()) + sizeof(MessageHeader));
+            REQUIRE(std::all_of(payload.begin(), payload.end(), [](std::byte b) { return b == std::byte{0}; }));
+        }
+
+        REQUIRE(scope.counts().allocations() == 1);
+        REQUIRE(scope.counts().allocated_bytes() == sizeof(MessageHeader) + 100);
+        REQUIRE(scope.counts().deallocations() == 1);
+    }
+
+    SECTION("separate payload vector takes two allocations")
+    {
+        Instrumentation::Scope scope;
+        auto message = ExplainStd::make_unique<Message>(7u, std::vector<std::byte>(100));
+
+        REQUIRE(scope.counts().allocations() == 2);
+    }
+
+    SECTION("tail is aligned for its elements")
+    {
+        auto lines = TailAllocation::make_unique_with_tail<char, CacheLine>(3, 'x');
+
+        REQUIRE(*lines == 'x');
+        REQUIRE(reinterpret_cast<uintptr_t>(lines.get()) % alignof(CacheLine) == 0);
+        REQUIRE(reinterpret_cast<uintptr_t>(TailAllocation::tail(lines).data()) % alignof(CacheLine) == 0);
+        REQUIRE(reinterpret_cast<const std::byte*>(TailAllocation::tail(lines).data()) - reinterpret_cast<const std::byte*>(lines.get()) == 64);
+    }
+
+    SECTION("over-aligned header")
+    {
+        auto wide = TailAllocation::make_unique_with_tail<WideHeader, char>(5, 3.14);
+
+        REQUIRE(reinterpret_cast<uintptr_t>(wide.get()) % alignof(WideHeader) == 0);
+        REQUIRE(reinterpret_cast<const std::byte*>(TailAllocation::tail(wide).data()) - reinterpret_cast<const std::byte*>(wide.get()) == 32);
+    }
+
+    SECTION("elements are destroyed in reverse order, then the header")
+    {
+        destruction_log.clear();
+        Numbered::next_id = 0;
+
+        auto numbers = TailAllocation::make_unique_with_tail<Numbered, Numbered>(3, -1);
+        REQUIRE(TailAllocation::tail(numbers)[2].id == 2);
+
+        numbers.reset();
+        REQUIRE(destruction_log == std::vector{2, 1, 0, -1});
+    }
+
+    SECTION("an element constructor that throws - constructed objects are destroyed & memory released")
+    {
+        destruction_log.clear();
+        Numbered::next_id = 0;
+        Numbered::throw_at = 2;
+
+        Instrumentation::Scope scope;
+        REQUIRE_THROWS_AS((TailAllocation::make_unique_with_tail<Numbered, Numbered>(4, -1)), std::runtime_error);
+        Numbered::throw_at = -1;
+
+        REQUIRE(destruction_log == std::vector{1, 0, -1});
+        REQUIRE(scope.counts().allocations() == scope.counts().deallocations());
+    }
+
+    SECTION("empty tail - only the header")
+    {
+        destruction_log.clear();
+        Numbered::next_id = 0;
+
+        auto header_only = TailAllocation::make_unique_with_tail<Numbered, Numbered>(0, -1);
+        REQUIRE(TailAllocation::tail(header_only).empty());
+
+        header_only.reset();
+        REQUIRE(destruction_log == std::vector{-1});
+
+        destruction_log.clear();
+        Numbered::throw_at = 0; // the first element throws - nothing in the tail to destroy
+        REQUIRE_THROWS_AS((TailAllocation::make_unique_with_tail<Numbered, Numbered>(2, -1)), std::runtime_error);
+        Numbered::throw_at = -1;
+
+        REQUIRE(destruction_log == std::vector{-1});
+    }
+}
+
+TEST_CASE("variadic templates - make_unique_with_tail - benchmarks", "[.][benchmark]")
+{
+    constexpr uint32_t payload_size = 256;
+
+    BENCHMARK("make_unique<Message>(type, vector<std::byte>(256)) - two allocations")
+    {
+        return std::make_unique<Message>(7u, std::vector<std::byte>(payload_size));
+    };
+
+    BENCHMARK("make_unique_with_tail<MessageHeader, std::byte>(256, ...)")
+    {
+        return TailAllocation::make_unique_with_tail<MessageHeader, std::byte>(payload_size, 7u, payload_size);
+    };
+
+    BENCHMARK("make_unique_with_tail_for_overwrite<MessageHeader, std::byte>(256, ...)")
+    {
+        return TailAllocation::make_unique_with_tail_for_overwrite<MessageHeader, std::byte>(payload_size, 7u, payload_size);
+    };
+
+    BENCHMARK("make_unique<std::byte[]>(4096)")
+    {
+        return ExplainStd::make_unique<std::byte[]>(4096);
+    };
+
+    BENCHMARK("make_unique_for_overwrite<std::byte[]>(4096)")
+    {
+        return ExplainStd::make_unique_for_overwrite<std::byte[]>(4096);
+    };
+
+    // reading header & payload - one cache line chain per message instead of two
+    constexpr size_t message_count = 10'000;
+
+    std::vector<std::unique_ptr<Message>> messages;
+    std::vector<TailAllocation::unique_ptr_with_tail<MessageHeader, std::byte>> tail_messages;
+    for (size_t i = 0; i < message_count; ++i)
+    {
+        messages.push_back(std::make_unique<Message>(7u, std::vector<std::byte>(payload_size, std::byte{1})));
+        tail_messages.push_back(TailAllocation::make_unique_with_tail<MessageHeader, std::byte>(payload_size, 7u, payload_size));
+    }
+
+    BENCHMARK("10000 x Message - read type & first payload byte")
+    {
+        uint64_t sum = 0;
+        for (const auto& message : messages)
+            sum += message->type + std::to_integer<uint32_t>(message->payload.front());
+        return sum;
+    };
+
+    BENCHMARK("10000 x MessageHeader with tail - read type & first payload byte")
+    {
+        uint64_t sum = 0;
+        for (const auto& message : tail_messages)
+            sum += message->type + std::to_integer<uint32_t>(TailAllocation::tail(message).front());
+        return sum;
+    };
+}
+
 // void print()
 // {
 //     std::cout << "\n";
@@ -97,4 +573,567 @@ void print_fold(TArgs... args)
 TEST_CASE("print_fold")
 {
     print_fold(1, 42, "ctext", "text"s);
-}
\ No newline at end of file
+}
+////////////////////////////////////////////////
+// buffered print - thread local buffer, numbers formatted with std::to_chars
+
+namespace Buffered
+{
+    inline constexpr size_t buffer_size = 4096;
+
+    // complete lines only - a line longer than the buffer continues in overflow
+    struct Chunk
+    {
+        std::FILE* file{};
+        size_t size{};
+        char data[buffer_size];
+        std::string overflow; // keeps its capacity when the chunk is recycled
+
+        void write()
+        {
+            std::fwrite(data, 1, size, file); // one fwrite per chunk
+            if (!overflow.empty())
+            {
+                std::fwrite(overflow.data(), 1, overflow.size(), file);
+                overflow.clear();
+            }
+        }
+    };
+
+    // bounded lock-free MPMC queue (D. Vyukov) - handoff of chunks between writers & flusher thread
+    template <typename T, size_t Capacity>
+    class BoundedQueue
+    {
+        static_assert(std::has_single_bit(Capacity));
+
+        struct Cell
+        {
+            std::atomic<size_t> sequence;
+            T value;
+        };
+
+        Cell cells[Capacity];
+        alignas(64) std::atomic<size_t> enqueue_pos{0};
+        alignas(64) std::atomic<size_t> dequeue_pos{0};
+
+    public:
+        BoundedQueue()
+        {
+            for (size_t i = 0; i < Capacity; ++i)
+                cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        bool try_push(T value)
+        {
+            size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+            while (true)
+            {
+                Cell& cell = cells[pos & (Capacity - 1)];
+                const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+                const auto diff = static_cast<std::ptrdiff_t>(sequence - pos);
+
+                if (diff == 0)
+                {
+                    if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        cell.value = std::move(value);
+                        cell.sequence.store(pos + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (diff < 0)
+                    return false; // full
+                else
+                    pos = enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+
+        bool try_pop(T& value)
+        {
+            size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+            while (true)
+            {
+                Cell& cell = cells[pos & (Capacity - 1)];
+                const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+                const auto diff = static_cast<std::ptrdiff_t>(sequence - (pos + 1));
+
+                if (diff == 0)
+                {
+                    if (dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        value = std::move(cell.value);
+                        cell.sequence.store(pos + Capacity, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (diff < 0)
+                    return false; // empty
+                else
+                    pos = dequeue_pos.load(std::memory_order_relaxed);
+            }
+        }
+    };
+
+    // background thread that writes full chunks - chunks are recycled, so steady state does not allocate
+    class Flusher
+    {
+        BoundedQueue<Chunk*, 64> full_chunks;
+        BoundedQueue<Chunk*, 64> free_chunks;
+        std::atomic<size_t> pending{0}; // submitted but not yet written
+        std::atomic<bool> done{false};
+        std::thread worker;
+
+        Flusher()
+            : worker{[this] { run(); }}
+        { }
+
+        void run()
+        {
+            Chunk* chunk;
+            while (true)
+            {
+                if (full_chunks.try_pop(chunk))
+                {
+                    chunk->write();
+                    release(chunk);
+                    pending.fetch_sub(1, std::memory_order_release);
+                    pending.notify_all();
+                }
+                else if (done.load(std::memory_order_acquire))
+                    break;
+                else if (pending.load(std::memory_order_acquire) == 0)
+                    pending.wait(0, std::memory_order_acquire);
+                else
+                    std::this_thread::yield(); // push in progress
+            }
+        }
+
+    public:
+        Flusher(const Flusher&) = delete;
+        Flusher& operator=(const Flusher&) = delete;
+
+        ~Flusher()
+        {
+            drain();
+            done.store(true, std::memory_order_release);
+            pending.fetch_add(1); // wake up worker
+            pending.notify_all();
+            worker.join();
+
+            Chunk* chunk;
+            while (free_chunks.try_pop(chunk))
+                delete chunk;
+        }
+
+        static Flusher& instance()
+        {
+            static Flusher flusher;
+            return flusher;
+        }
+
+        Chunk* acquire()
+        {
+            Chunk* chunk;
+            if (free_chunks.try_pop(chunk))
+                return chunk;
+            return new Chunk;
+        }
+
+        void release(Chunk* chunk)
+        {
+            if (!free_chunks.try_push(chunk))
+                delete chunk;
+        }
+
+        void submit(Chunk* chunk)
+        {
+            pending.fetch_add(1, std::memory_order_release);
+            while (!full_chunks.try_push(chunk)) // backpressure keeps order of chunks from one thread
+                std::this_thread::yield();
+            pending.notify_all();
+        }
+
+        void drain()
+        {
+            for (size_t count = pending.load(std::memory_order_acquire); count != 0; count = pending.load(std::memory_order_acquire))
+                pending.wait(count, std::memory_order_acquire);
+        }
+    };
+
+    // submit(chunk, line_end) - writes [0, line_end) of a chunk, returns a chunk starting with the rest (an unfinished line)
+
+    struct DirectFlush
+    {
+        static Chunk* acquire()
+        {
+            return new Chunk;
+        }
+
+        static Chunk* submit(Chunk* chunk, size_t line_end)
+        {
+            const size_t rest = chunk->size - line_end;
+            chunk->size = line_end;
+            chunk->write();
+
+            std::memmove(chunk->data, chunk->data + line_end, rest);
+            chunk->size = rest;
+            return chunk;
+        }
+
+        static void release(Chunk* chunk)
+        {
+            delete chunk;
+        }
+    };
+
+    struct BackgroundFlush
+    {
+        static Chunk* acquire()
+        {
+            return Flusher::instance().acquire();
+        }
+
+        static Chunk* submit(Chunk* chunk, size_t line_end)
+        {
+            Chunk* next = Flusher::instance().acquire();
+            next->size = chunk->size - line_end;
+            std::memcpy(next->data, chunk->data + line_end, next->size);
+
+            chunk->size = line_end;
+            Flusher::instance().submit(chunk);
+            return next;
+        }
+
+        static void release(Chunk* chunk)
+        {
+            Flusher::instance().release(chunk);
+        }
+    };
+
+    template <typename T>
+    concept Printable = std::is_arithmetic_v<T> || std::convertible_to<const T&, std::string_view>;
+
+    template <typename TFlushPolicy = DirectFlush>
+    class Writer
+    {
+        std::FILE* file;
+        Chunk* chunk;
+        size_t line_begin = 0; // a chunk is handed over at line boundaries - lines of threads sharing a file do not interleave
+
+        void submit(size_t line_end)
+        {
+            chunk = TFlushPolicy::submit(chunk, line_end);
+            chunk->file = file;
+            line_begin = 0;
+        }
+
+        void put(std::string_view text)
+        {
+            if (chunk->overflow.empty() && chunk->size + text.size() > buffer_size && line_begin > 0)
+                submit(line_begin); // the complete lines - the current one moves to the front of the next chunk
+
+            if (!chunk->overflow.empty() || chunk->size + text.size() > buffer_size)
+            {
+                chunk->overflow.append(text); // a line longer than the buffer
+                return;
+            }
+
+            std::memcpy(chunk->data + chunk->size, text.data(), text.size());
+            chunk->size += text.size();
+        }
+
+        template <Printable T>
+        void put_item(const T& item)
+        {
+            if constexpr (std::same_as<T, char> || std::same_as<T, signed char> || std::same_as<T, unsigned char> || std::same_as<T, char8_t>)
+            {
+                const char c = static_cast<char>(item); // as std::cout - int8_t & uint8_t are characters too
+                put(std::string_view{&c, 1});
+            }
+            else if constexpr (std::same_as<T, bool>)
+                put(item ? "1" : "0"); // as std::cout without std::boolalpha
+            else if constexpr (std::is_floating_point_v<T>)
+            {
+                char text[32];
+                put(std::string_view{text, std::to_chars(text, text + sizeof(text), item, std::chars_format::general, 6).ptr}); // as std::cout - %g
+            }
+            else if constexpr (std::is_arithmetic_v<T>)
+            {
+                char text[32];
+                put(std::string_view{text, std::to_chars(text, text + sizeof(text), item).ptr});
+            }
+            else
+                put(std::string_view{item});
+        }
+
+    public:
+        explicit Writer(std::FILE* file = stdout)
+            : file{file}
+            , chunk{TFlushPolicy::acquire()}
+        {
+            chunk->file = file;
+            chunk->size = 0;
+        }
+
+        Writer(const Writer&) = delete;
+        Writer& operator=(const Writer&) = delete;
+
+        ~Writer()
+        {
+            flush();
+            TFlushPolicy::release(chunk);
+        }
+
+        // the same output as print(args...) - items followed by a space, line ended with "\n"
+        template <Printable... TArgs>
+        void print(const TArgs&... args)
+        {
+            (..., (put_item(args), put(" ")));
+            put("\n");
+
+            if (!chunk->overflow.empty())
+                flush();
+            line_begin = chunk->size;
+        }
+
+        void flush()
+        {
+            if (chunk->size == 0 && chunk->overflow.empty())
+                return;
+
+            submit(chunk->size);
+        }
+    };
+
+    template <typename TFlushPolicy = DirectFlush>
+    Writer<TFlushPolicy>& thread_writer()
+    {
+        thread_local Writer<TFlushPolicy> writer{stdout};
+        return writer;
+    }
+
+    // output is flushed when the buffer is full, on flush() or at thread exit
+    template <typename TFlushPolicy = DirectFlush, Printable... TArgs>
+    void print(const TArgs&... args)
+    {
+        thread_writer<TFlushPolicy>().print(args...);
+    }
+
+    template <typename TFlushPolicy = DirectFlush>
+    void flush()
+    {
+        thread_writer<TFlushPolicy>().flush();
+
+        if constexpr (std::same_as<TFlushPolicy, BackgroundFlush>)
+            Flusher::instance().drain();
+
+        std::fflush(stdout);
+    }
+} // namespace Buffered
+
+namespace
+{
+    std::string read_all(std::FILE* file)
+    {
+        std::fflush(file);
+        std::rewind(file);
+
+        std::string content;
+        char buffer[1024];
+        while (size_t count = std::fread(buffer, 1, sizeof(buffer), file))
+            content.append(buffer, count);
+
+        return content;
+    }
+} // namespace
+
+TEST_CASE("Buffered::print")
+{
+    SECTION("same output as print")
+    {
+        std::FILE* file = std::tmpfile();
+        {
+            Buffered::Writer writer{file};
+            writer.print(1, 42.5, "ctext", "text"s, 'c', -665L, true);
+        }
+        REQUIRE(read_all(file) == "1 42.5 ctext text c -665 1 \n");
+        std::fclose(file);
+    }
+
+    SECTION("int8_t & uint8_t are characters - as print")
+    {
+        std::ostringstream expected;
+        std::streambuf* cout_buffer = std::cout.rdbuf(expected.rdbuf());
+        print(int8_t{'A'}, uint8_t{'B'}, static_cast<signed char>('c'), static_cast<unsigned char>('d'));
+        std::cout.rdbuf(cout_buffer);
+
+        std::FILE* file = std::tmpfile();
+        {
+            Buffered::Writer writer{file};
+            writer.print(int8_t{'A'}, uint8_t{'B'}, static_cast<signed char>('c'), static_cast<unsigned char>('d'));
+        }
+
+        REQUIRE(expected.str() == "A B c d \n");
+        REQUIRE(read_all(file) == expected.str());
+        std::fclose(file);
+    }
+
+    SECTION("floating point - the default format of std::ostream (%g)")
+    {
+        std::FILE* file = std::tmpfile();
+        {
+            Buffered::Writer writer{file};
+            writer.print(3.14159265, 1234567.0, 0.0001, 1e-5, 100000.0, 2.5f, -0.0);
+        }
+
+        std::ostringstream expected;
+        for (double value : {3.14159265, 1234567.0, 0.0001, 1e-5, 100000.0, 2.5, -0.0})
+            expected << value << " ";
+        expected << "\n";
+
+        REQUIRE(expected.str() == "3.14159 1.23457e+06 0.0001 1e-05 100000 2.5 -0 \n");
+        REQUIRE(read_all(file) == expected.str());
+        std::fclose(file);
+    }
+
+    SECTION("lines longer than buffer")
+    {
+        std::FILE* file = std::tmpfile();
+        const std::string long_text(3 * Buffered::buffer_size + 7, 'x');
+        {
+            Buffered::Writer writer{file};
+            for (int i = 0; i < 3; ++i)
+                writer.print(long_text, i);
+        }
+        REQUIRE(read_all(file) == long_text + " 0 \n" + long_text + " 1 \n" + long_text + " 2 \n");
+        std::fclose(file);
+    }
+
+    SECTION("background flusher - many threads")
+    {
+        std::FILE* file = std::tmpfile();
+        constexpr int thread_count = 4;
+        constexpr int lines_per_thread = 5'000;
+        {
+            std::vector<std::jthread> threads;
+            for (int t = 0; t < thread_count; ++t)
+                threads.emplace_back([file, t] {
+                    Buffered::Writer<Buffered::BackgroundFlush> writer{file};
+                    for (int i = 0; i < lines_per_thread; ++i)
+                        writer.print("thread", t, "line", i);
+                });
+        }
+        Buffered::Flusher::instance().drain();
+
+        const std::string content = read_all(file);
+        REQUIRE(std::ranges::count(content, '\n') == thread_count * lines_per_thread);
+        for (int t = 0; t < thread_count; ++t)
+        {
+            const std::string last_line = "thread " + std::to_string(t) + " line " + std::to_string(lines_per_thread - 1) + " \n";
+            REQUIRE(content.find(last_line) != std::string::npos);
+        }
+        std::fclose(file);
+    }
+
+    SECTION("background flusher - lines of threads do not interleave")
+    {
+        std::FILE* file = std::tmpfile();
+        constexpr int thread_count = 4;
+        constexpr int lines_per_thread = 2'000;
+        {
+            std::vector<std::jthread> threads;
+            for (int t = 0; t < thread_count; ++t)
+                threads.emplace_back([file, t] {
+                    Buffered::Writer<Buffered::BackgroundFlush> writer{file};
+                    for (int i = 0; i < lines_per_thread; ++i)
+                    {
+                        // chunks fill in the middle of lines, every 100th line is longer than a chunk
+                        const std::string text(i % 100 == 0 ? 2 * Buffered::buffer_size : 50 + i % 150, static_cast<char>('a' + t));
+                        writer.print(text, i);
+                    }
+                });
+        }
+        Buffered::Flusher::instance().drain();
+
+        std::istringstream content{read_all(file)};
+        int line_count = 0;
+        for (std::string line; std::getline(content, line); ++line_count)
+        {
+            const size_t text_end = line.find(' ');
+            REQUIRE(text_end != std::string::npos);
+
+            const int i = std::stoi(line.substr(text_end + 1));
+            const size_t expected_length = i % 100 == 0 ? 2 * Buffered::buffer_size : 50 + i % 150;
+            REQUIRE(text_end == expected_length);
+            REQUIRE(line.find_first_not_of(line[0]) == text_end);
+            REQUIRE(line.substr(text_end) == " " + std::to_string(i) + " ");
+        }
+        REQUIRE(line_count == thread_count * lines_per_thread);
+        std::fclose(file);
+    }
+
+    SECTION("call shape of print")
+    {
+        Buffered::print(1, 42.3, "ctext", "text"s);
+        Buffered::flush();
+    }
+}
+
+#if __has_include(<unistd.h>)
+#include <fcntl.h>
+#include <unistd.h>
+
+TEST_CASE("Buffered::print - benchmarks", "[.][benchmark]")
+{
+    constexpr int line_count = 1'000'000;
+
+    // stdout is redirected to /dev/null while lines are printed
+    auto lines_per_second = [](auto print_lines) {
+        std::cout.flush();
+        std::fflush(stdout);
+        const int stdout_fd = ::dup(STDOUT_FILENO);
+        const int null_fd = ::open("/dev/null", O_WRONLY);
+        ::dup2(null_fd, STDOUT_FILENO);
+
+        const auto start = std::chrono::steady_clock::now();
+        print_lines();
+        const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+
+        ::dup2(stdout_fd, STDOUT_FILENO);
+        ::close(null_fd);
+        ::close(stdout_fd);
+
+        return line_count / elapsed.count();
+    };
+
+    const double cout_print = lines_per_second([] {
+        for (int i = 0; i < line_count; ++i)
+            print(i, 42.3, "ctext", "text"s);
+        std::cout.flush();
+    });
+
+    const double cout_print_fold = lines_per_second([] {
+        for (int i = 0; i < line_count; ++i)
+            print_fold(i, 42.3, "ctext", "text"s);
+        std::cout.flush();
+    });
+
+    const double buffered_direct = lines_per_second([] {
+        for (int i = 0; i < line_count; ++i)
+            Buffered::print(i, 42.3, "ctext", "text"s);
+        Buffered::flush();
+    });
+
+    const double buffered_background = lines_per_second([] {
+        for (int i = 0; i < line_count; ++i)
+            Buffered::print<Buffered::BackgroundFlush>(i, 42.3, "ctext", "text"s);
+        Buffered::flush<Buffered::BackgroundFlush>();
+    });
+
+    std::cout << "lines/s:"
+              << "\n  print (std::cout):                 " << static_cast<long>(cout_print)
+              << "\n  print_fold (std::cout):            " << static_cast<long>(cout_print_fold)
+              << "\n  Buffered::print - DirectFlush:     " << static_cast<long>(buffered_direct)
+              << "\n  Buffered::print - BackgroundFlush: " << static_cast<long>(buffered_background) << "\n";
+}
+#endif